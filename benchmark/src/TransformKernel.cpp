@@ -0,0 +1,94 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <Engine/system/TransformKernel.hpp>
+#include <Engine/system/TransformSystem.hpp>
+
+using engine::core::TransformSystem;
+using engine::core::simd::ISA;
+
+namespace {
+
+// same layout as the pools of Position3f / Rotation3f / Scale3f
+struct Transforms {
+    explicit Transforms(std::size_t count) : position(count), rotation(count), scale(count)
+    {
+        std::mt19937 gen{42};
+        std::uniform_real_distribution<float> pos{-100.0f, 100.0f};
+        std::uniform_real_distribution<float> angle{-360.0f, 360.0f};
+        std::uniform_real_distribution<float> factor{0.1f, 10.0f};
+        for (auto i = 0ul; i != count; i++) {
+            position[i] = {pos(gen), pos(gen), pos(gen)};
+            rotation[i] = {angle(gen), angle(gen), angle(gen)};
+            scale[i] = {factor(gen), factor(gen), factor(gen)};
+        }
+    }
+
+    std::vector<glm::vec3> position;
+    std::vector<glm::vec3> rotation;
+    std::vector<glm::vec3> scale;
+};
+
+auto BM_TransformGLM(benchmark::State &state) -> void
+{
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const Transforms transforms{count};
+    std::vector<glm::mat4> out(count);
+
+    for (auto _ : state) {
+        for (auto i = 0ul; i != count; i++) {
+            out[i] =
+                TransformSystem::compute(transforms.position[i], transforms.rotation[i], transforms.scale[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// note : include the gather to a structure of arrays done by TransformSystem::update
+template<ISA isa>
+auto BM_TransformKernel(benchmark::State &state) -> void
+{
+    if (!engine::core::simd::is_supported(isa)) {
+        state.SkipWithError("instruction set not supported by this cpu");
+        return;
+    }
+
+    const auto count = static_cast<std::size_t>(state.range(0));
+    const Transforms transforms{count};
+    std::vector<float> soa(count * 9);
+    std::vector<glm::mat4> out(count);
+
+    const auto input = [&soa, count](std::size_t component) { return soa.data() + component * count; };
+    const engine::core::simd::TransformInputs inputs{
+        {input(0), input(1), input(2)}, {input(3), input(4), input(5)}, {input(6), input(7), input(8)}};
+
+    for (auto _ : state) {
+        for (auto i = 0ul; i != count; i++) {
+            for (auto axis = 0; axis != 3; axis++) {
+                const auto index = static_cast<std::size_t>(axis);
+                input(0 + index)[i] = transforms.position[i][axis];
+                input(3 + index)[i] = transforms.rotation[i][axis];
+                input(6 + index)[i] = transforms.scale[i][axis];
+            }
+        }
+        engine::core::simd::compute_transforms(inputs, glm::value_ptr(out.front()), count, isa);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_TransformGLM)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_TransformKernel, ISA::SCALAR)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_TransformKernel, ISA::SSE4)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_TransformKernel, ISA::AVX2)->Arg(1'000)->Arg(100'000)->Arg(1'000'000);
+
+BENCHMARK_MAIN();
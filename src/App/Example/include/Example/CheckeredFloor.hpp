@@ -37,8 +37,12 @@ public:
                 const auto y_int = static_cast<int>(y) + ((number_of_square % 2) && (y < 0.0f));
                 const auto is_dark_tile = ((x_int % 2) || (y_int % 2)) && !((x_int % 2) && (y_int % 2));
 
-                VBO<VAO::Attribute::POSITION>::emplace(world, square, data::square_positions, 3);
-                VBO<VAO::Attribute::COLOR>::emplace(world, square, is_dark_tile ? dark_color : light_color, 4);
+                Vertices::emplace(
+                    world,
+                    square,
+                    VertexLayout::compact(),
+                    data::square_positions,
+                    is_dark_tile ? dark_color : light_color);
                 EBO::emplace(world, square, data::square_indices);
 
                 world.emplace<Position3f>(
@@ -47,6 +51,7 @@ public:
                 world.emplace<Scale3f>(square, glm::vec3{size_of_square, size_of_square, size_of_square});
 
                 world.emplace<Name>(square, fmt::format("cf_{}_{}", int{x}, int{y}));
+                world.emplace<Static>(square);
 
                 m_previous.emplace_back(square);
             }
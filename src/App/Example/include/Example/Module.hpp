@@ -25,27 +25,28 @@ public:
         m_world = &world;
         /*        for (int i = 1; i != 1000; i++) {
                     const auto triangle = world.create();
-                    engine::api::VBO<engine::api::VAO::Attribute::POSITION>::emplace(world, triangle,
-           data::triangle_positions, 3); engine::api::VBO<engine::api::VAO::Attribute::COLOR>::emplace(world,
-           triangle, data::triangle_colors, 4); world.emplace<engine::api::Position3f>(triangle, glm::vec3{i
-           * 1.5, 0, 0}); world.emplace<engine::api::Rotation3f>(triangle, glm::vec3{i * 10, i * 10, i * 10});
+                    engine::api::Vertices::emplace(world, triangle, engine::api::VertexLayout{},
+           data::triangle_positions, data::triangle_colors);
+                    world.emplace<engine::api::Position3f>(triangle, glm::vec3{i * 1.5, 0, 0});
+                    world.emplace<engine::api::Rotation3f>(triangle, glm::vec3{i * 10, i * 10, i * 10});
                     world.emplace<engine::api::Scale3f>(triangle, glm::vec3{i, i, i});
                 }
 
                 {
                     const auto square = world.create();
-                    engine::api::VBO<engine::api::VAO::Attribute::POSITION>::emplace(world, square,
-           data::square_positions, 3); engine::api::VBO<engine::api::VAO::Attribute::COLOR>::emplace(world,
-           square, data::square_colors, 4); engine::api::EBO::emplace(world, square, data::square_indices);
+                    engine::api::Vertices::emplace(world, square, engine::api::VertexLayout{},
+           data::square_positions, data::square_colors);
+                    engine::api::EBO::emplace(world, square, data::square_indices);
                 }
         */
 
         {
             const auto cube = world.create();
-            engine::api::VBO<engine::api::VAO::Attribute::POSITION>::emplace(world, cube, data::cube_positions, 3);
-            engine::api::VBO<engine::api::VAO::Attribute::COLOR>::emplace(world, cube, data::cube_colors, 4);
+            engine::api::Vertices::emplace(
+                world, cube, engine::api::VertexLayout{}, data::cube_positions, data::cube_colors);
             engine::api::EBO::emplace(world, cube, data::cube_indices);
             world.emplace<engine::api::Position3f>(cube, glm::vec3{0, 0, 0.0f});
+            world.emplace<engine::api::Occluder>(cube);
         }
 
         floor.create(floor.m_size_of_square, floor.m_number_of_square, world);
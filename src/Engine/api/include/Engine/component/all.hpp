@@ -1,15 +1,27 @@
 #pragma once
 
 #include <cstdint>
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <tuple>
 #include <variant>
+#include <vector>
 
 #include <entt/entt.hpp>
 #include <spdlog/spdlog.h>
 #include <magic_enum.hpp>
 #include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
 
 #include "Engine/third_party.hpp"
+#include "Engine/helpers/hash.hpp"
+#include "Engine/helpers/packing.hpp"
+#include "Engine/helpers/simplify.hpp"
+#include "Engine/resource/Buffer.hpp"
+#include "Engine/resource/ObjectPool.hpp"
 
 namespace engine {
 namespace api {
@@ -48,75 +60,452 @@ struct VAO {
 
     unsigned int object;
     DisplayMode mode;
+
+    // first index in the element buffer attached, the buffers of the meshes are ranges of larger blocks
+    GLsizei first;
     GLsizei count;
 
+    // identify the content of the buffers attached, two VAO with the same value draw the same mesh
+    std::uint64_t content_hash;
+
     static constexpr DisplayMode DEFAULT_MODE{DisplayMode::TRIANGLES};
 
     static auto emplace(entt::registry &world, const entt::entity &entity) -> VAO &
     {
         spdlog::trace("engine::core::VAO: emplace to {}", entity);
-        VAO obj{0u, DEFAULT_MODE, 0};
-        CALL_OPEN_GL(::glGenVertexArrays(1, &obj.object));
+        const auto vertex_array = world.ctx<ObjectPool>().acquire(ObjectPool::Type::VERTEX_ARRAY);
+        const VAO obj{vertex_array, DEFAULT_MODE, 0, 0, 0u};
         return world.emplace<VAO>(entity, obj);
     }
 
     static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
     {
         spdlog::trace("engine::core::VAO: destroy of {}", entity);
-        const auto &vao = world.get<VAO>(entity);
-        CALL_OPEN_GL(::glDeleteVertexArrays(1, &vao.object));
+        world.ctx<ObjectPool>().release(ObjectPool::Type::VERTEX_ARRAY, world.get<VAO>(entity).object);
     }
 
     enum class Attribute { POSITION, COLOR, NORMALS };
 };
 
-template<VAO::Attribute A>
-struct VBO {
-     static std::string name;
-    // static constexpr std::string_view name{"VBO" + magic_enum::enum_name(A)};
+// bounds of the vertices in local space, computed when the positions are uploaded
+struct AABB {
+    static constexpr std::string_view name{"AABB"};
 
-    unsigned int object;
+    glm::vec3 min;
+    glm::vec3 max;
+};
 
-    template<std::size_t S>
-    static auto
-        emplace(entt::registry &world, const entt::entity &entity, const std::array<float, S> &vertices, int stride_size)
-            -> VBO<A> &
+// Format of the vertices of a Vertices component, the attributes are interleaved in a single buffer
+//
+// The attributes follow the order of VAO::Attribute, each one padded to 4 bytes. The gpu converts the packed
+// values back to floats when fetching the vertices, so the shaders keep their vec3 / vec4 inputs. The
+// octahedral normals are the exception : a vec2 to give to decode_octahedral (see helpers/packing.hpp).
+struct VertexLayout {
+    enum class Format : std::uint8_t {
+        NONE,       // the attribute is not stored
+        FLOAT32,
+        FLOAT16,
+        SNORM16,    // in [-1, 1], for the meshes modeled in the unit cube and scaled by their transform
+        UNORM8,     // in [0, 1], for the colors
+        OCTAHEDRAL, // unit vector folded in two snorm16, for the normals
+    };
+
+    static constexpr std::size_t ATTRIBUTES{3};
+
+    // floats per vertex of each attribute, as read by the shaders
+    static constexpr std::array<std::size_t, ATTRIBUTES> COMPONENTS{3, 4, 3};
+
+    Format position{Format::FLOAT32};
+    Format color{Format::FLOAT32};
+    Format normal{Format::NONE};
+
+    // 12 bytes per vertex instead of 28, 16 with the normals
+    static constexpr auto compact() noexcept
+    {
+        return VertexLayout{Format::FLOAT16, Format::UNORM8, Format::OCTAHEDRAL};
+    }
+
+    constexpr auto operator==(const VertexLayout &) const noexcept -> bool = default;
+
+    [[nodiscard]] constexpr auto format(VAO::Attribute attribute) const noexcept -> Format
+    {
+        switch (attribute) {
+        case VAO::Attribute::POSITION: return position;
+        case VAO::Attribute::COLOR: return color;
+        case VAO::Attribute::NORMALS: return normal;
+        }
+        return Format::NONE;
+    }
+
+    // in bytes
+    [[nodiscard]] constexpr auto size(VAO::Attribute attribute) const noexcept -> std::size_t
+    {
+        const auto components = COMPONENTS[static_cast<std::size_t>(attribute)];
+        switch (format(attribute)) {
+        case Format::NONE: return 0;
+        case Format::FLOAT32: return components * 4;
+        case Format::FLOAT16:
+        case Format::SNORM16: return (components * 2 + 3) / 4 * 4;
+        case Format::UNORM8: return (components + 3) / 4 * 4;
+        case Format::OCTAHEDRAL: return 4;
+        }
+        return 0;
+    }
+
+    [[nodiscard]] constexpr auto offset(VAO::Attribute attribute) const noexcept -> std::size_t
+    {
+        std::size_t result{0};
+        for (std::size_t i = 0; i != static_cast<std::size_t>(attribute); i++) {
+            result += size(static_cast<VAO::Attribute>(i));
+        }
+        return result;
+    }
+
+    [[nodiscard]] constexpr auto stride() const noexcept -> std::size_t
+    {
+        return offset(VAO::Attribute::NORMALS) + size(VAO::Attribute::NORMALS);
+    }
+
+    // enable the stored attributes of the vertex array and point them to the buffer at binding
+    // note : the vertices start at buffer_offset in the buffer
+    auto setup(GLuint vao, GLuint buffer, GLuint binding, std::size_t buffer_offset = 0) const -> void
+    {
+        for (std::size_t i = 0; i != ATTRIBUTES; i++) {
+            const auto attribute = static_cast<VAO::Attribute>(i);
+            auto components = static_cast<GLint>(COMPONENTS[i]);
+            GLenum type{GL_FLOAT};
+            GLboolean normalized{GL_FALSE};
+            switch (format(attribute)) {
+            case Format::NONE: continue;
+            case Format::FLOAT32: break;
+            case Format::FLOAT16: type = GL_HALF_FLOAT; break;
+            case Format::SNORM16:
+                type = GL_SHORT;
+                normalized = GL_TRUE;
+                break;
+            case Format::UNORM8:
+                type = GL_UNSIGNED_BYTE;
+                normalized = GL_TRUE;
+                break;
+            case Format::OCTAHEDRAL:
+                components = 2;
+                type = GL_SHORT;
+                normalized = GL_TRUE;
+                break;
+            }
+
+            const auto location = static_cast<GLuint>(i);
+            CALL_OPEN_GL(::glEnableVertexArrayAttrib(vao, location));
+            CALL_OPEN_GL(::glVertexArrayAttribFormat(
+                vao, location, components, type, normalized, static_cast<GLuint>(offset(attribute))));
+            CALL_OPEN_GL(::glVertexArrayAttribBinding(vao, location, binding));
+        }
+        CALL_OPEN_GL(::glVertexArrayVertexBuffer(
+            vao, binding, buffer, static_cast<GLintptr>(buffer_offset), static_cast<GLsizei>(stride())));
+    }
+
+    // interleave and convert the attributes, each span holding COMPONENTS floats per vertex
+    [[nodiscard]] auto
+        encode(std::size_t count, const std::array<std::span<const float>, ATTRIBUTES> &attributes) const
+        -> std::vector<std::byte>
+    {
+        std::vector<std::byte> result(count * stride());
+        const auto write = [&result](std::size_t at, auto value) {
+            std::memcpy(result.data() + at, &value, sizeof(value));
+            return at + sizeof(value);
+        };
+
+        for (std::size_t i = 0; i != ATTRIBUTES; i++) {
+            const auto attribute = static_cast<VAO::Attribute>(i);
+            const auto components = COMPONENTS[i];
+            const auto &source = attributes[i];
+            for (std::size_t vertex = 0; vertex != count && format(attribute) != Format::NONE; vertex++) {
+                const auto values = source.subspan(vertex * components, components);
+                auto at = vertex * stride() + offset(attribute);
+                if (format(attribute) == Format::OCTAHEDRAL) {
+                    const auto encoded = encode_octahedral(glm::vec3{values[0], values[1], values[2]});
+                    at = write(at, glm::packSnorm1x16(encoded.x));
+                    write(at, glm::packSnorm1x16(encoded.y));
+                    continue;
+                }
+                for (const auto value : values) {
+                    switch (format(attribute)) {
+                    case Format::FLOAT32: at = write(at, value); break;
+                    case Format::FLOAT16: at = write(at, glm::packHalf1x16(value)); break;
+                    case Format::SNORM16: at = write(at, glm::packSnorm1x16(value)); break;
+                    case Format::UNORM8: at = write(at, glm::packUnorm1x8(value)); break;
+                    case Format::NONE:
+                    case Format::OCTAHEDRAL: break;
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    // convert an attribute back to floats, the components not stored are the defaults of the gpu (0, 0, 0, 1)
+    [[nodiscard]] auto decode(std::span<const std::byte> vertices, VAO::Attribute attribute) const
+        -> std::vector<glm::vec4>
+    {
+        const auto count = stride() == 0 ? 0 : vertices.size() / stride();
+        std::vector<glm::vec4> result(count, glm::vec4{0.0f, 0.0f, 0.0f, 1.0f});
+        if (format(attribute) == Format::NONE) { return result; }
+
+        const auto read = [&vertices]<typename T>(std::size_t at, T &value) {
+            std::memcpy(&value, vertices.data() + at, sizeof(value));
+            return at + sizeof(value);
+        };
+
+        const auto components = COMPONENTS[static_cast<std::size_t>(attribute)];
+        for (std::size_t vertex = 0; vertex != count; vertex++) {
+            auto &value = result[vertex];
+            auto at = vertex * stride() + offset(attribute);
+            if (format(attribute) == Format::OCTAHEDRAL) {
+                std::array<std::uint16_t, 2> encoded{};
+                at = read(at, encoded[0]);
+                read(at, encoded[1]);
+                value = glm::vec4{
+                    decode_octahedral({glm::unpackSnorm1x16(encoded[0]), glm::unpackSnorm1x16(encoded[1])}),
+                    value.w};
+                continue;
+            }
+            for (std::size_t i = 0; i != components; i++) {
+                const auto component = static_cast<glm::length_t>(i);
+                float f32{0.0f};
+                std::uint16_t u16{0};
+                std::uint8_t u8{0};
+                switch (format(attribute)) {
+                case Format::FLOAT32:
+                    at = read(at, f32);
+                    value[component] = f32;
+                    break;
+                case Format::FLOAT16:
+                    at = read(at, u16);
+                    value[component] = glm::unpackHalf1x16(u16);
+                    break;
+                case Format::SNORM16:
+                    at = read(at, u16);
+                    value[component] = glm::unpackSnorm1x16(u16);
+                    break;
+                case Format::UNORM8:
+                    at = read(at, u8);
+                    value[component] = glm::unpackUnorm1x8(u8);
+                    break;
+                case Format::NONE:
+                case Format::OCTAHEDRAL: break;
+                }
+            }
+        }
+        return result;
+    }
+};
+
+// vertices of the entity interleaved in a single buffer, shared by the entities with the same content
+struct Vertices {
+    static constexpr std::string_view name{"Vertices"};
+
+    // vertex buffer binding of the vertex array, distinct from the one of the instanced attributes
+    static constexpr GLuint BINDING{0};
+
+    BufferRange range;
+
+    // id of the shared buffer in the BufferCache
+    entt::id_type resource;
+
+    VertexLayout layout;
+    std::uint32_t count;
+
+    // note : each span holds VertexLayout::COMPONENTS floats per vertex, the attributes without data are not
+    // stored whatever their format in the layout
+    static auto emplace(
+        entt::registry &world,
+        const entt::entity &entity,
+        VertexLayout layout,
+        std::span<const float> positions,
+        std::span<const float> colors = {},
+        std::span<const float> normals = {}) -> Vertices &
     {
-        spdlog::trace("engine::core::VBO<{}>: emplace to {}", magic_enum::enum_name(A).data(), entity);
+        spdlog::trace("engine::core::Vertices: emplace to {}", entity);
 
         const VAO *vao{nullptr};
         if (vao = world.try_get<VAO>(entity); !vao) { vao = &VAO::emplace(world, entity); }
-        CALL_OPEN_GL(::glBindVertexArray(vao->object));
 
-        VBO<A> obj{0u};
-        CALL_OPEN_GL(::glGenBuffers(1, &obj.object));
+        const auto attributes = std::to_array({positions, colors, normals});
+        const auto formats = std::to_array({&layout.position, &layout.color, &layout.normal});
+        auto vertices = positions.size() / VertexLayout::COMPONENTS[0];
+        for (std::size_t i = 0; i != VertexLayout::ATTRIBUTES; i++) {
+            if (attributes[i].empty()) { *formats[i] = VertexLayout::Format::NONE; }
+            if (*formats[i] == VertexLayout::Format::NONE) { continue; }
+
+            const auto available = attributes[i].size() / VertexLayout::COMPONENTS[i];
+            if (available != vertices) {
+                spdlog::warn(
+                    "engine::core::Vertices: {} has {} vertices of {}, expected {}",
+                    entity,
+                    available,
+                    magic_enum::enum_name(static_cast<VAO::Attribute>(i)).data(),
+                    vertices);
+                vertices = std::min(vertices, available);
+            }
+        }
+        if (layout.position == VertexLayout::Format::SNORM16) {
+            const auto outside = [](auto value) { return value < -1.0f || value > 1.0f; };
+            if (std::any_of(positions.begin(), positions.end(), outside)) {
+                spdlog::warn("engine::core::Vertices: the positions of {} are clamped in [-1, 1]", entity);
+            }
+        }
+
+        const auto data = layout.encode(vertices, attributes);
+        const auto hash = hash_bytes(data.data(), data.size(), hash_bytes(&layout, sizeof(layout)));
+
+        // note : the vertex buffer binding starts at the offset, the draws index the vertices from 0
+        const auto [resource, range] = world.ctx<BufferCache>().acquire(hash, data.data(), data.size(), 4);
+        layout.setup(vao->object, range.buffer, BINDING, range.offset);
+
+        world.patch<VAO>(entity, [hash, vertices](VAO &vao_obj) {
+            vao_obj.count = static_cast<GLsizei>(vertices);
+            vao_obj.content_hash ^= hash;
+        });
+
+        constexpr auto MAX = std::numeric_limits<float>::max();
+        AABB bounds{glm::vec3{MAX}, glm::vec3{-MAX}};
+        for (const auto &point : layout.decode(data, VAO::Attribute::POSITION)) {
+            bounds.min = glm::min(bounds.min, glm::vec3{point});
+            bounds.max = glm::max(bounds.max, glm::vec3{point});
+        }
+        world.emplace_or_replace<AABB>(entity, bounds);
+
+        const Vertices obj{range, resource, layout, static_cast<std::uint32_t>(vertices)};
+        return world.emplace<Vertices>(entity, obj);
+    }
+
+    // read the attribute back from the gpu, converted to floats
+    [[nodiscard]] auto read(VAO::Attribute attribute) const -> std::vector<glm::vec4>
+    {
+        std::vector<std::byte> data(count * layout.stride());
+        CALL_OPEN_GL(::glGetNamedBufferSubData(
+            range.buffer,
+            static_cast<GLintptr>(range.offset),
+            static_cast<GLsizeiptr>(data.size()),
+            data.data()));
+        return layout.decode(data, attribute);
+    }
+
+    static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
+    {
+        spdlog::trace("engine::core::Vertices: destroy of {}", entity);
+        world.ctx<BufferCache>().release(world.get<Vertices>(entity).resource);
+    }
+};
+
+// simplified versions of the indices of a triangle mesh, generated when the indices are uploaded
+struct LOD {
+    static constexpr std::string_view name{"LOD"};
+
+    static constexpr std::size_t MAX_LEVELS{4};
 
-        CALL_OPEN_GL(::glBindBuffer(GL_ARRAY_BUFFER, obj.object));
-        CALL_OPEN_GL(::glBufferData(GL_ARRAY_BUFFER, S * sizeof(float), vertices.data(), GL_STATIC_DRAW));
-        CALL_OPEN_GL(::glVertexAttribPointer(
-            static_cast<GLuint>(A), stride_size, GL_FLOAT, GL_FALSE, stride_size * static_cast<int>(sizeof(float)), 0));
-        CALL_OPEN_GL(::glEnableVertexAttribArray(static_cast<GLuint>(A)));
+    // the meshes smaller than this are always drawn at full detail
+    static constexpr std::size_t MIN_TRIANGLES{64};
 
-        world.patch<VAO>(entity, [](VAO &vao_obj) { vao_obj.count = S; });
+    // each level targets half of the triangles of the previous one, within this error (relative to the size)
+    static constexpr std::array<float, MAX_LEVELS> MAX_ERRORS{0.0f, 0.01f, 0.03f, 0.08f};
 
-        return world.emplace<VBO<A>>(entity, obj);
+    // range of the level in the element buffer, in indices from VAO::first
+    struct Level {
+        GLsizei first;
+        GLsizei count;
+    };
+
+    // element buffer holding every level, the level 0 being the indices as uploaded
+    BufferRange range;
+
+    // id of the shared buffer in the BufferCache
+    entt::id_type resource;
+
+    std::array<Level, MAX_LEVELS> levels;
+    std::uint32_t count;
+
+    // level to draw, selected each frame by the engine
+    std::uint32_t current;
+
+    // radius of the bounds in local space
+    float radius;
+
+    // note : the element buffer of the vertex array of the entity is replaced by the levels
+    template<std::size_t S>
+    static auto emplace(
+        [[maybe_unused]] entt::registry &world,
+        [[maybe_unused]] const entt::entity &entity,
+        [[maybe_unused]] const std::array<std::uint32_t, S> &indices) -> void
+    {
+        if constexpr (S % 3 != 0 || S / 3 < MIN_TRIANGLES) {
+            return;
+        } else {
+            const auto vertices = world.try_get<Vertices>(entity);
+            if (world.get<VAO>(entity).mode != VAO::DisplayMode::TRIANGLES || vertices == nullptr) { return; }
+
+            // note : the positions are not kept on the cpu, they are read back once for the generation
+            constexpr std::size_t components{3};
+            std::vector<float> positions;
+            positions.reserve(vertices->count * components);
+            for (const auto &point : vertices->read(VAO::Attribute::POSITION)) {
+                positions.insert(positions.end(), {point.x, point.y, point.z});
+            }
+
+            LOD obj{{}, 0u, {}, 1u, 0u, 0.0f};
+            obj.levels[0] = {0, static_cast<GLsizei>(S)};
+
+            std::vector<std::uint32_t> all(indices.begin(), indices.end());
+            for (; obj.count != MAX_LEVELS; obj.count++) {
+                const auto &previous = obj.levels[obj.count - 1];
+                const auto source = std::span<const std::uint32_t>{all}.subspan(
+                    static_cast<std::size_t>(previous.first), static_cast<std::size_t>(previous.count));
+                const auto simplified = simplify(
+                    source,
+                    positions,
+                    components,
+                    source.size() / 6 * 3,
+                    MAX_ERRORS[obj.count]);
+                // note : a level removing less than a quarter of the triangles is not worth a switch
+                if (simplified.size() * 4 > source.size() * 3) { break; }
+
+                obj.levels[obj.count] = {
+                    static_cast<GLsizei>(all.size()), static_cast<GLsizei>(simplified.size())};
+                all.insert(all.end(), simplified.begin(), simplified.end());
+            }
+            if (obj.count == 1) { return; }
+
+            const auto bytes = all.size() * sizeof(std::uint32_t);
+            const auto hash = hash_bytes(all.data(), bytes, hash_bytes(name.data(), name.size()));
+            std::tie(obj.resource, obj.range) =
+                world.ctx<BufferCache>().acquire(hash, all.data(), bytes, sizeof(std::uint32_t));
+            CALL_OPEN_GL(::glVertexArrayElementBuffer(world.get<VAO>(entity).object, obj.range.buffer));
+            world.patch<VAO>(entity, [&obj](VAO &vao_obj) {
+                vao_obj.first = static_cast<GLsizei>(obj.range.offset / sizeof(std::uint32_t));
+            });
+
+            if (const auto bounds = world.try_get<AABB>(entity); bounds) {
+                obj.radius = glm::length(bounds->max - bounds->min) * 0.5f;
+            }
+
+            world.emplace<LOD>(entity, obj);
+        }
     }
 
     static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
     {
-        spdlog::trace("engine::core::VBO<{}>: destroy of {}", magic_enum::enum_name(A).data(), entity);
-        const auto &vbo = world.get<VBO<A>>(entity);
-        CALL_OPEN_GL(::glDeleteBuffers(1, &vbo.object));
+        spdlog::trace("engine::core::LOD: destroy of {}", entity);
+        world.ctx<BufferCache>().release(world.get<LOD>(entity).resource);
     }
 };
 
-template<VAO::Attribute A>
-std::string VBO<A>::name = std::string("VBO") + magic_enum::enum_name(A).data();
-
 struct EBO {
     static constexpr std::string_view name{"EBO"};
 
-    unsigned int object;
+    BufferRange range;
+
+    // id of the shared buffer in the BufferCache
+    entt::id_type resource;
 
     template<std::size_t S>
     static auto
@@ -127,24 +516,44 @@ struct EBO {
 
         const VAO *vao{nullptr};
         if (vao = world.try_get<VAO>(entity); !vao) { vao = &VAO::emplace(world, entity); }
-        CALL_OPEN_GL(::glBindVertexArray(vao->object));
 
-        EBO obj{};
-        CALL_OPEN_GL(::glGenBuffers(1, &obj.object));
+        const auto hash =
+            hash_bytes(vertices.data(), S * sizeof(std::uint32_t), hash_bytes(name.data(), name.size()));
+
+        const auto [resource, range] = world.ctx<BufferCache>().acquire(
+            hash, vertices.data(), S * sizeof(std::uint32_t), sizeof(std::uint32_t));
+        EBO obj{range, resource};
 
-        CALL_OPEN_GL(::glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, obj.object));
-        CALL_OPEN_GL(::glBufferData(GL_ELEMENT_ARRAY_BUFFER, S * sizeof(float), vertices.data(), GL_STATIC_DRAW));
+        // note : attached without binding, the emplace paths leave the state of the renderer untouched
+        CALL_OPEN_GL(::glVertexArrayElementBuffer(vao->object, obj.range.buffer));
 
-        world.patch<VAO>(entity, [](VAO &vao_obj) { vao_obj.count = S; });
+        world.patch<VAO>(entity, [hash, &obj](VAO &vao_obj) {
+            vao_obj.first = static_cast<GLsizei>(obj.range.offset / sizeof(std::uint32_t));
+            vao_obj.count = S;
+            vao_obj.content_hash ^= hash;
+        });
 
-        return world.emplace<EBO>(entity);
+        auto &ebo = world.emplace<EBO>(entity, obj);
+        LOD::emplace(world, entity, vertices);
+        return ebo;
+    }
+
+    // read the indices back from the gpu
+    [[nodiscard]] auto read() const -> std::vector<std::uint32_t>
+    {
+        std::vector<std::uint32_t> indices(range.size / sizeof(std::uint32_t));
+        CALL_OPEN_GL(::glGetNamedBufferSubData(
+            range.buffer,
+            static_cast<GLintptr>(range.offset),
+            static_cast<GLsizeiptr>(indices.size() * sizeof(std::uint32_t)),
+            indices.data()));
+        return indices;
     }
 
     static auto on_destroy(entt::registry &world, const entt::entity &entity) -> void
     {
         spdlog::trace("engine::core::EBO: destroy of {}", entity);
-        const auto &ebo = world.get<EBO>(entity);
-        CALL_OPEN_GL(::glDeleteBuffers(1, &ebo.object));
+        world.ctx<BufferCache>().release(world.get<EBO>(entity).resource);
     }
 };
 
@@ -175,6 +584,37 @@ struct Scale {
 
 using Scale3f = Scale<3, float>;
 
+template<std::size_t D, typename T>
+struct Tint {
+    static constexpr std::string_view name{"Tint"};
+
+    glm::vec<static_cast<int>(D), T> vec;
+};
+
+using Tint4f = Tint<4, float>;
+
+// tag of the entities which do not move once created, the engine merges their meshes in batches
+// note : a static entity can still be modified, its vertices are then transformed again
+struct Static {
+    static constexpr std::string_view name{"Static"};
+};
+
+// tag of the entities hiding the ones behind them, their triangles are rasterized on the cpu by the engine
+// note : keep the occluders large and simple, a wall or a building rather than a detailed mesh
+struct Occluder {
+    static constexpr std::string_view name{"Occluder"};
+};
+
+// world matrix computed from Position / Rotation / Scale, maintained by the engine
+struct Transform {
+    static constexpr std::string_view name{"Transform"};
+
+    glm::mat4 world;
+
+    // index of the matrix in the gpu copy
+    std::uint32_t slot;
+};
+
 struct Name {
     static constexpr std::string_view name{"Name"};
 
@@ -182,7 +622,35 @@ struct Name {
 };
 
 using Component =
-    std::variant<std::monostate, VAO, EBO, VBO<VAO::Attribute::POSITION>, VBO<VAO::Attribute::COLOR>, Position3f, Rotation3f, Scale3f, Name>;
+    std::variant<std::monostate, VAO, EBO, Vertices, Position3f, Rotation3f, Scale3f, Tint4f, Name>;
+
+// compact the BufferCache of the registry and point the vertex arrays to the moved ranges, return their count
+// note : the VAO are updated in place, the content of the meshes is unchanged
+inline auto defragment(entt::registry &world) -> std::size_t
+{
+    auto &cache = world.ctx<BufferCache>();
+    const auto moved = cache.defragment();
+
+    world.view<Vertices, VAO>().each([&cache](Vertices &vertices, const VAO &vao) {
+        vertices.range = cache.range(vertices.resource);
+        vertices.layout.setup(vao.object, vertices.range.buffer, Vertices::BINDING, vertices.range.offset);
+    });
+
+    const auto attach = [](VAO &vao, const BufferRange &range) {
+        CALL_OPEN_GL(::glVertexArrayElementBuffer(vao.object, range.buffer));
+        vao.first = static_cast<GLsizei>(range.offset / sizeof(std::uint32_t));
+    };
+    world.view<EBO, VAO>().each([&cache, &attach](EBO &ebo, VAO &vao) {
+        ebo.range = cache.range(ebo.resource);
+        attach(vao, ebo.range);
+    });
+    // note : the levels replace the element buffer of the EBO
+    world.view<LOD, VAO>().each([&cache, &attach](LOD &lod, VAO &vao) {
+        lod.range = cache.range(lod.resource);
+        attach(vao, lod.range);
+    });
+    return moved;
+}
 
 } // namespace api
 } // namespace engine
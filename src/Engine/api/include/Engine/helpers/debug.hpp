@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string_view>
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace api {
+
+// Group the GL calls of a scope in the debug messages and in the frame debuggers (RenderDoc, Nsight ...)
+// note : only pushed when a message callback is installed, KHR_debug may be missing otherwise
+class DebugGroup {
+public:
+    explicit DebugGroup(std::string_view name) : m_active{core::debug_output != core::DebugOutput::POLL}
+    {
+        if (!m_active) { return; }
+        CALL_OPEN_GL(::glPushDebugGroup(
+            GL_DEBUG_SOURCE_APPLICATION, 0, static_cast<GLsizei>(name.size()), name.data()));
+    }
+
+    ~DebugGroup()
+    {
+        if (m_active) { CALL_OPEN_GL(::glPopDebugGroup()); }
+    }
+
+    DebugGroup(const DebugGroup &) = delete;
+    DebugGroup &operator=(const DebugGroup &) = delete;
+
+private:
+    bool m_active;
+};
+
+// Name a GL object in the debug messages and in the frame debuggers, identifier is GL_BUFFER, GL_QUERY ...
+inline auto debug_label(GLenum identifier, GLuint name, std::string_view label) -> void
+{
+    if (core::debug_output == core::DebugOutput::POLL) { return; }
+    CALL_OPEN_GL(::glObjectLabel(identifier, name, static_cast<GLsizei>(label.size()), label.data()));
+}
+
+} // namespace api
+} // namespace engine
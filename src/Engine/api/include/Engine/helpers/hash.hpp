@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace engine {
+namespace api {
+
+// FNV-1a over raw bytes, used to identify the content of the gpu buffers
+inline constexpr std::uint64_t HASH_SEED{14695981039346656037ull};
+
+inline auto hash_bytes(const void *data, std::size_t size, std::uint64_t seed = HASH_SEED) noexcept
+    -> std::uint64_t
+{
+    constexpr std::uint64_t PRIME{1099511628211ull};
+
+    const auto bytes = static_cast<const unsigned char *>(data);
+    for (auto i = 0ul; i != size; i++) {
+        seed ^= bytes[i];
+        seed *= PRIME;
+    }
+    return seed;
+}
+
+} // namespace api
+} // namespace engine
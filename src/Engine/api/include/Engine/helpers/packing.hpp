@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string_view>
+
+#include <glm/glm.hpp>
+
+namespace engine {
+namespace api {
+
+// Map a unit vector on an octahedron unfolded in [-1, 1]^2 (Cigolle et al. 2014)
+// note : the error stays under 0.01 degree once stored in two snorm16
+inline auto encode_octahedral(const glm::vec3 &normal) noexcept -> glm::vec2
+{
+    const auto sum = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+    if (sum == 0.0f) { return glm::vec2{0.0f}; }
+
+    const auto n = normal / sum;
+    if (n.z >= 0.0f) { return glm::vec2{n.x, n.y}; }
+
+    // note : the lower half is folded over the diagonals
+    return glm::vec2{
+        (1.0f - glm::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+        (1.0f - glm::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f)};
+}
+
+inline auto decode_octahedral(const glm::vec2 &encoded) noexcept -> glm::vec3
+{
+    auto n = glm::vec3{encoded, 1.0f - glm::abs(encoded.x) - glm::abs(encoded.y)};
+    if (n.z < 0.0f) {
+        n.x = (1.0f - glm::abs(encoded.y)) * (encoded.x >= 0.0f ? 1.0f : -1.0f);
+        n.y = (1.0f - glm::abs(encoded.x)) * (encoded.y >= 0.0f ? 1.0f : -1.0f);
+    }
+    const auto length = glm::length(n);
+    return length == 0.0f ? glm::vec3{0.0f, 0.0f, 1.0f} : n / length;
+}
+
+// decode_octahedral for the shaders reading the normals of a VertexLayout, inserted after the #version line
+inline constexpr std::string_view DECODE_OCTAHEDRAL_GLSL{R"(
+vec3 decode_octahedral(vec2 encoded)
+{
+    vec3 n = vec3(encoded, 1.0f - abs(encoded.x) - abs(encoded.y));
+    if (n.z < 0.0f) {
+        n.xy = (1.0f - abs(encoded.yx)) * mix(vec2(-1.0f), vec2(1.0f), greaterThanEqual(encoded, vec2(0.0f)));
+    }
+    return normalize(n);
+}
+)"};
+
+} // namespace api
+} // namespace engine
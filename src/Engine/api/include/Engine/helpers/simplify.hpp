@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace engine {
+namespace api {
+
+namespace detail {
+
+// symmetric 4x4 matrix summing the squared distances to a set of planes (Garland & Heckbert 1997)
+struct Quadric {
+    // a2, ab, ac, ad, b2, bc, bd, c2, cd, d2
+    std::array<double, 10> m{};
+
+    static auto from_plane(const glm::dvec3 &n, double d, double weight) noexcept -> Quadric
+    {
+        return {{weight * n.x * n.x,
+                 weight * n.x * n.y,
+                 weight * n.x * n.z,
+                 weight * n.x * d,
+                 weight * n.y * n.y,
+                 weight * n.y * n.z,
+                 weight * n.y * d,
+                 weight * n.z * n.z,
+                 weight * n.z * d,
+                 weight * d * d}};
+    }
+
+    auto operator+=(const Quadric &other) noexcept -> Quadric &
+    {
+        for (std::size_t i = 0; i != m.size(); i++) { m[i] += other.m[i]; }
+        return *this;
+    }
+
+    [[nodiscard]] auto error(const glm::dvec3 &p) const noexcept -> double
+    {
+        return m[0] * p.x * p.x + 2.0 * m[1] * p.x * p.y + 2.0 * m[2] * p.x * p.z + 2.0 * m[3] * p.x
+               + m[4] * p.y * p.y + 2.0 * m[5] * p.y * p.z + 2.0 * m[6] * p.y + m[7] * p.z * p.z
+               + 2.0 * m[8] * p.z + m[9];
+    }
+};
+
+} // namespace detail
+
+// Reduce a triangle list to about target_count indices by collapsing edges, cheapest quadric error first.
+// Only the indices change : a vertex always collapses onto one of its neighbours, the vertex buffer is reused
+// as is. Open borders (and so the attribute seams) are locked to avoid cracks. The collapses moving a point
+// further than max_error (relative to the size of the mesh) are rejected.
+inline auto simplify(
+    std::span<const std::uint32_t> indices,
+    std::span<const float> positions,
+    std::size_t stride,
+    std::size_t target_count,
+    float max_error) -> std::vector<std::uint32_t>
+{
+    const auto vertex_count = positions.size() / stride;
+
+    std::vector<glm::dvec3> points(vertex_count);
+    glm::dvec3 min{std::numeric_limits<double>::max()};
+    glm::dvec3 max{-std::numeric_limits<double>::max()};
+    for (std::size_t i = 0; i != vertex_count; i++) {
+        points[i] = {
+            static_cast<double>(positions[i * stride]),
+            static_cast<double>(positions[i * stride + 1]),
+            stride > 2 ? static_cast<double>(positions[i * stride + 2]) : 0.0};
+        min = glm::min(min, points[i]);
+        max = glm::max(max, points[i]);
+    }
+    const auto limit = glm::length(max - min) * static_cast<double>(max_error);
+    const auto max_cost = limit * limit;
+
+    std::vector<std::uint32_t> result(indices.begin(), indices.end());
+
+    std::vector<detail::Quadric> quadrics(vertex_count);
+    for (std::size_t i = 0; i + 2 < result.size(); i += 3) {
+        const auto &a = points[result[i]];
+        const auto normal = glm::cross(points[result[i + 1]] - a, points[result[i + 2]] - a);
+        const auto area = glm::length(normal);
+        if (area == 0.0) { continue; }
+        const auto n = normal / area;
+        const auto plane = detail::Quadric::from_plane(n, -glm::dot(n, a), area);
+        for (std::size_t j = 0; j != 3; j++) { quadrics[result[i + j]] += plane; }
+    }
+
+    const auto flips = [&points](const std::uint32_t *triangle, std::uint32_t from, std::uint32_t to) {
+        std::array<glm::dvec3, 3> before;
+        std::array<glm::dvec3, 3> after;
+        for (std::size_t j = 0; j != 3; j++) {
+            before[j] = points[triangle[j]];
+            after[j] = points[triangle[j] == from ? to : triangle[j]];
+        }
+        const auto n0 = glm::cross(before[1] - before[0], before[2] - before[0]);
+        const auto n1 = glm::cross(after[1] - after[0], after[2] - after[0]);
+        // note : a normal turning by more than ~75 degrees is a flip or a sliver in the making
+        return glm::dot(n0, n1) <= 0.25 * glm::length(n0) * glm::length(n1);
+    };
+
+    struct Collapse {
+        std::uint32_t from;
+        std::uint32_t to;
+        double cost;
+    };
+
+    std::vector<std::uint32_t> remap(vertex_count);
+    std::vector<bool> locked(vertex_count);
+    std::vector<bool> touched(vertex_count);
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+    std::vector<Collapse> collapses;
+    std::vector<std::uint32_t> adjacency_offsets(vertex_count + 1);
+    std::vector<std::uint32_t> adjacency;
+
+    // note : every pass collapses at most one edge per neighbourhood so the adjacency stays valid
+    while (result.size() > target_count) {
+        const auto triangle_count = result.size() / 3;
+
+        edges.clear();
+        for (std::size_t i = 0; i != result.size(); i += 3) {
+            for (std::size_t j = 0; j != 3; j++) {
+                const auto a = result[i + j];
+                const auto b = result[i + (j + 1) % 3];
+                edges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        std::fill(locked.begin(), locked.end(), false);
+        collapses.clear();
+        for (std::size_t i = 0; i != edges.size();) {
+            auto j = i + 1;
+            while (j != edges.size() && edges[j] == edges[i]) { j++; }
+            const auto [a, b] = edges[i];
+            if (j - i == 1) {
+                locked[a] = true;
+                locked[b] = true;
+            } else {
+                collapses.push_back({a, b, 0.0});
+            }
+            i = j;
+        }
+
+        for (auto &collapse : collapses) {
+            auto quadric = quadrics[collapse.from];
+            quadric += quadrics[collapse.to];
+            // note : a locked vertex never moves, its edges can only collapse toward it
+            const auto cost_to = locked[collapse.from] ? max_cost + 1.0 : quadric.error(points[collapse.to]);
+            const auto cost_from =
+                locked[collapse.to] ? max_cost + 1.0 : quadric.error(points[collapse.from]);
+            if (cost_from < cost_to) { std::swap(collapse.from, collapse.to); }
+            collapse.cost = std::min(cost_to, cost_from);
+        }
+        std::erase_if(collapses, [max_cost](const auto &collapse) { return collapse.cost > max_cost; });
+        std::sort(collapses.begin(), collapses.end(), [](const auto &lhs, const auto &rhs) {
+            return lhs.cost < rhs.cost;
+        });
+
+        std::fill(adjacency_offsets.begin(), adjacency_offsets.end(), 0u);
+        for (const auto index : result) { adjacency_offsets[index + 1]++; }
+        std::partial_sum(adjacency_offsets.begin(), adjacency_offsets.end(), adjacency_offsets.begin());
+        adjacency.resize(result.size());
+        auto cursor = adjacency_offsets;
+        for (std::size_t i = 0; i != result.size(); i++) {
+            adjacency[cursor[result[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+
+        std::iota(remap.begin(), remap.end(), 0u);
+        std::fill(touched.begin(), touched.end(), false);
+
+        auto remaining = triangle_count;
+        std::size_t collapsed{0};
+        for (const auto &[from, to, cost] : collapses) {
+            if (remaining * 3 <= target_count) { break; }
+            if (touched[from] || touched[to]) { continue; }
+
+            const auto first = adjacency.begin() + adjacency_offsets[from];
+            const auto last = adjacency.begin() + adjacency_offsets[from + 1];
+
+            std::size_t removed{0};
+            bool flipped{false};
+            for (auto it = first; it != last && !flipped; ++it) {
+                const auto *triangle = &result[*it * 3];
+                if (triangle[0] == to || triangle[1] == to || triangle[2] == to) {
+                    removed++;
+                } else {
+                    flipped = flips(triangle, from, to);
+                }
+            }
+            if (flipped) { continue; }
+
+            remap[from] = to;
+            quadrics[to] += quadrics[from];
+            for (auto it = first; it != last; ++it) {
+                for (std::size_t j = 0; j != 3; j++) { touched[result[*it * 3 + j]] = true; }
+            }
+            remaining -= removed;
+            collapsed++;
+        }
+
+        if (collapsed == 0) { break; }
+
+        std::size_t write{0};
+        for (std::size_t i = 0; i != result.size(); i += 3) {
+            const auto a = remap[result[i]];
+            const auto b = remap[result[i + 1]];
+            const auto c = remap[result[i + 2]];
+            if (a == b || b == c || c == a) { continue; }
+            result[write++] = a;
+            result[write++] = b;
+            result[write++] = c;
+        }
+        result.resize(write);
+    }
+
+    return result;
+}
+
+} // namespace api
+} // namespace engine
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "Engine/third_party.hpp"
+#include "Engine/resource/BufferAllocator.hpp"
+
+namespace engine {
+namespace api {
+
+// Range of a GL buffer shared by the components uploading the same content
+struct Buffer {
+    BufferAllocator::Allocation allocation;
+
+    std::uint64_t content_hash;
+    std::size_t size;
+    std::size_t alignment;
+
+    // number of components using the buffer
+    std::size_t references{0};
+
+    BufferAllocator &allocator;
+
+    Buffer(
+        BufferAllocator &ranges, std::uint64_t hash, const void *data, std::size_t bytes, std::size_t align) :
+        allocation{ranges.allocate(bytes, align)},
+        content_hash{hash},
+        size{bytes},
+        alignment{align},
+        allocator{ranges}
+    {
+        CALL_OPEN_GL(::glNamedBufferSubData(
+            allocation.range.buffer,
+            static_cast<GLintptr>(allocation.range.offset),
+            static_cast<GLsizeiptr>(size),
+            data));
+    }
+
+    // note : the range is reused once the gpu is done with it
+    ~Buffer() { allocator.release(allocation); }
+
+    Buffer(const Buffer &) = delete;
+    Buffer &operator=(const Buffer &) = delete;
+};
+
+struct BufferLoader : entt::resource_loader<BufferLoader, Buffer> {
+    auto load(
+        BufferAllocator &allocator,
+        std::uint64_t hash,
+        const void *data,
+        std::size_t size,
+        std::size_t alignment) const -> std::shared_ptr<Buffer>
+    {
+        return std::make_shared<Buffer>(allocator, hash, data, size, alignment);
+    }
+};
+
+// Buffers indexed by their content, stored in the context of the registry
+//
+// note : the ranges come from the BufferAllocator of the registry, the cache must be destroyed before it
+class BufferCache {
+public:
+    explicit BufferCache(BufferAllocator &allocator) : m_allocator{allocator} {}
+
+    // return the id and the range holding data, the data is only uploaded if no buffer has the same content
+    // note : the offset is a multiple of alignment, e.g. the vertex stride to draw from a base vertex
+    auto acquire(std::uint64_t hash, const void *data, std::size_t size, std::size_t alignment = 1)
+        -> std::pair<entt::id_type, BufferRange>
+    {
+        // note : the full 64 bits hash indexes the buffers, the size and alignment tell apart the collisions
+        const auto [first, last] = m_index.equal_range(hash);
+        for (auto it = first; it != last; ++it) {
+            if (auto handle = m_cache.handle(it->second);
+                handle->size == size && handle->alignment == alignment) {
+                handle->references++;
+                return {it->second, handle->allocation.range};
+            }
+        }
+
+        const auto id = m_next_id++;
+        auto handle = m_cache.load<BufferLoader>(id, m_allocator, hash, data, size, alignment);
+        handle->references++;
+        m_index.emplace(hash, id);
+        return {id, handle->allocation.range};
+    }
+
+    // the range is freed when its last reference is released
+    auto release(entt::id_type id) -> void
+    {
+        auto handle = m_cache.handle(id);
+        if (!handle || --handle->references != 0) { return; }
+
+        const auto [first, last] = m_index.equal_range(handle->content_hash);
+        m_index.erase(std::find_if(first, last, [id](const auto &entry) { return entry.second == id; }));
+        m_cache.discard(id);
+    }
+
+    [[nodiscard]] auto range(entt::id_type id) const -> BufferRange
+    {
+        return m_cache.handle(id)->allocation.range;
+    }
+
+    [[nodiscard]] auto size() const { return m_cache.size(); }
+
+    // move every buffer to new blocks, packed from the largest, and free the previous ones, return the count
+    // note : the ranges held by the components are outdated afterward, see api::defragment
+    auto defragment() -> std::size_t
+    {
+        m_allocator.retire();
+
+        std::vector<entt::id_type> ids;
+        ids.reserve(m_cache.size());
+        m_cache.each([&ids](const entt::id_type id) { ids.push_back(id); });
+        std::sort(ids.begin(), ids.end(), [this](auto lhs, auto rhs) {
+            return m_cache.handle(lhs)->size > m_cache.handle(rhs)->size;
+        });
+
+        for (const auto id : ids) {
+            auto handle = m_cache.handle(id);
+            const auto previous = handle->allocation;
+            handle->allocation = m_allocator.allocate(handle->size, handle->alignment);
+            CALL_OPEN_GL(::glCopyNamedBufferSubData(
+                previous.range.buffer,
+                handle->allocation.range.buffer,
+                static_cast<GLintptr>(previous.range.offset),
+                static_cast<GLintptr>(handle->allocation.range.offset),
+                static_cast<GLsizeiptr>(handle->size)));
+            m_allocator.release(previous);
+        }
+        return ids.size();
+    }
+
+private:
+    BufferAllocator &m_allocator;
+
+    entt::resource_cache<Buffer> m_cache;
+
+    // content hash to the ids of m_cache, the ids are never reused
+    std::unordered_multimap<std::uint64_t, entt::id_type> m_index;
+    entt::id_type m_next_id{0};
+};
+
+} // namespace api
+} // namespace engine
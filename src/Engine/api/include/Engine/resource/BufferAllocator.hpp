@@ -0,0 +1,394 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "Engine/helpers/debug.hpp"
+#include "Engine/third_party.hpp"
+#include "Engine/resource/ObjectPool.hpp"
+
+namespace engine {
+namespace api {
+
+// range of a GL buffer, in bytes
+struct BufferRange {
+    unsigned int buffer;
+    std::size_t offset;
+    std::size_t size;
+};
+
+// Ranges of a few large GL buffers handed out to the small meshes, stored in the context of the registry
+//
+// The free ranges of the blocks are indexed by a two level segregated fit (TLSF, Masmano et al. 2004) : the
+// first level splits the sizes by powers of two, the second splits each power in SL_COUNT linear classes, and
+// a bitmap per level finds a class holding a large enough range in constant time. A released range is merged
+// with its free neighbours, a block left empty is given back to the ObjectPool. Like the names of the pool, a
+// released range is only reused once the fence of the frame which released it is signaled.
+// note : the allocator only manages the offsets, the content is uploaded by the caller
+class BufferAllocator {
+public:
+    static constexpr std::size_t BLOCK_SIZE{std::size_t{4} * 1024 * 1024};
+
+    // note : every range starts and ends on a multiple, the larger requests get a dedicated block
+    static constexpr std::size_t GRANULARITY{16};
+
+    struct Allocation {
+        BufferRange range;
+        std::uint32_t node;
+    };
+
+    struct Stats {
+        std::size_t blocks;
+        std::size_t reserved;     // bytes of the blocks
+        std::size_t used;         // bytes of the allocations, alignment and granularity included
+        std::size_t allocations;
+        std::size_t free_ranges;  // free ranges available to the allocations
+        std::size_t largest_free; // bytes of the largest of them
+        std::size_t pending;      // allocations released and waiting for their fence
+
+        // part of the free space out of reach of a single allocation, 0 when it is contiguous
+        [[nodiscard]] auto fragmentation() const noexcept -> double
+        {
+            const auto free = reserved - used;
+            if (free == 0) { return 0.0; }
+            return 1.0 - static_cast<double>(largest_free) / static_cast<double>(free);
+        }
+
+        [[nodiscard]] auto utilization() const noexcept -> double
+        {
+            if (reserved == 0) { return 1.0; }
+            return static_cast<double>(used) / static_cast<double>(reserved);
+        }
+    };
+
+    explicit BufferAllocator(ObjectPool &pool) : m_pool{pool} {}
+
+    ~BufferAllocator()
+    {
+        for (auto &frame : m_retired) { ::glDeleteSync(frame.fence); }
+        for (const auto &block : m_blocks) { m_pool.release(ObjectPool::Type::BUFFER, block.buffer); }
+    }
+
+    BufferAllocator(const BufferAllocator &) = delete;
+    BufferAllocator &operator=(const BufferAllocator &) = delete;
+
+    // the offset is a multiple of alignment, which does not have to be a power of two (e.g. a vertex stride)
+    // note : alignment is at least 1
+    [[nodiscard]] auto allocate(std::size_t size, std::size_t alignment = 1) -> Allocation
+    {
+        // note : the ranges start on a multiple of GRANULARITY, the other alignments are padded
+        const auto padding = GRANULARITY % alignment == 0 ? 0 : alignment - 1;
+        const auto bytes = align(std::max(size, std::size_t{1}) + padding, GRANULARITY);
+        const auto rounded = roundUp(bytes);
+
+        auto node = find(rounded);
+        if (node == NONE) {
+            createBlock(std::max(BLOCK_SIZE, rounded));
+            node = find(rounded);
+        }
+        unlink(node);
+        split(node, bytes);
+
+        auto &allocated = m_nodes[node];
+        allocated.free = false;
+        m_blocks[allocated.block].allocations++;
+        m_stats.used += allocated.size;
+        m_stats.allocations++;
+
+        const auto offset = align(allocated.offset, alignment);
+        return {{m_blocks[allocated.block].buffer, offset, size}, node};
+    }
+
+    // note : the range is reused a few frames later, it must not be used anymore
+    auto release(const Allocation &allocation) -> void { m_current.push_back(allocation.node); }
+
+    // called once per frame after the last draw call, free the ranges the gpu is done with
+    auto advance() -> void
+    {
+        if (!m_current.empty()) {
+            m_retired.push_back({::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), std::move(m_current)});
+            m_current = {};
+        }
+
+        // note : polled without flush, the fences are submitted with the next swap at the latest
+        while (!m_retired.empty()) {
+            auto &frame = m_retired.front();
+            if (::glClientWaitSync(frame.fence, 0, 0) == GL_TIMEOUT_EXPIRED) { break; }
+            ::glDeleteSync(frame.fence);
+            for (const auto node : frame.nodes) { free(node); }
+            m_retired.pop_front();
+        }
+
+        m_stats.pending = m_current.size();
+        for (const auto &frame : m_retired) { m_stats.pending += frame.nodes.size(); }
+        m_stats.largest_free = 0;
+        if (m_fl_bitmap != 0) {
+            const auto fl = msb(m_fl_bitmap);
+            const auto sl = msb(m_sl_bitmaps[fl]);
+            for (auto i = m_heads[fl][sl]; i != NONE; i = m_nodes[i].next_free) {
+                m_stats.largest_free = std::max(m_stats.largest_free, m_nodes[i].size);
+            }
+        }
+    }
+
+    // stop allocating from the current blocks, each one is given back once all its ranges are released
+    // note : used to compact the allocations, moved by their owner to new ranges (see BufferCache)
+    auto retire() -> void
+    {
+        for (std::uint32_t i = 0; i != m_nodes.size(); i++) {
+            const auto &node = m_nodes[i];
+            if (node.block != NONE && node.free && !m_blocks[node.block].retired) { unlink(i); }
+        }
+        for (std::uint32_t i = 0; i != m_blocks.size(); i++) {
+            if (m_blocks[i].buffer == 0) { continue; }
+            m_blocks[i].retired = true;
+            if (m_blocks[i].allocations == 0) { removeBlock(i); }
+        }
+    }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    static constexpr std::uint32_t NONE{~0u};
+
+    static constexpr unsigned SL_BITS{4};
+    static constexpr std::size_t SL_COUNT{std::size_t{1} << SL_BITS};
+    static constexpr std::size_t FL_COUNT{32};
+
+    // a free or allocated range of a block, linked to its neighbours in the block
+    struct Node {
+        std::size_t offset;
+        std::size_t size;
+        std::uint32_t block; // NONE when the node is unused
+        std::uint32_t previous;
+        std::uint32_t next;
+        std::uint32_t previous_free;
+        std::uint32_t next_free;
+        bool free;
+    };
+
+    struct Block {
+        unsigned int buffer; // 0 once given back
+        std::size_t size;
+        std::size_t allocations;
+        bool retired;
+    };
+
+    struct Frame {
+        GLsync fence;
+        std::vector<std::uint32_t> nodes;
+    };
+
+    template<typename T>
+    static constexpr auto msb(T value) noexcept -> std::size_t
+    {
+        return static_cast<std::size_t>(std::numeric_limits<T>::digits - 1 - std::countl_zero(value));
+    }
+
+    static constexpr auto align(std::size_t value, std::size_t alignment) noexcept -> std::size_t
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    // first and second level indices of the class holding the ranges of size bytes
+    static constexpr auto mapping(std::size_t size) noexcept -> std::pair<std::size_t, std::size_t>
+    {
+        const auto units = size / GRANULARITY;
+        if (units < SL_COUNT) { return {0, units}; }
+        const auto high = msb(units);
+        return {high - SL_BITS + 1, (units >> (high - SL_BITS)) - SL_COUNT};
+    }
+
+    // the size of the next class, any range of which holds size bytes
+    static constexpr auto roundUp(std::size_t size) noexcept -> std::size_t
+    {
+        const auto units = size / GRANULARITY;
+        if (units < SL_COUNT) { return size; }
+        const auto step = std::size_t{1} << (msb(units) - SL_BITS);
+        return align(units, step) * GRANULARITY;
+    }
+
+    auto find(std::size_t size) const noexcept -> std::uint32_t
+    {
+        auto [fl, sl] = mapping(size);
+        if (fl >= FL_COUNT) { return NONE; }
+
+        auto sl_map = m_sl_bitmaps[fl] & (~0u << sl);
+        if (sl_map == 0) {
+            const auto fl_map = fl + 1 < FL_COUNT ? m_fl_bitmap & (~0u << (fl + 1)) : 0u;
+            if (fl_map == 0) { return NONE; }
+            fl = static_cast<std::size_t>(std::countr_zero(fl_map));
+            sl_map = m_sl_bitmaps[fl];
+        }
+        sl = static_cast<std::size_t>(std::countr_zero(sl_map));
+        return m_heads[fl][sl];
+    }
+
+    auto insert(std::uint32_t index) noexcept -> void
+    {
+        auto &node = m_nodes[index];
+        const auto [fl, sl] = mapping(node.size);
+        auto &head = m_heads[fl][sl];
+
+        node.previous_free = NONE;
+        node.next_free = head;
+        if (head != NONE) { m_nodes[head].previous_free = index; }
+        head = index;
+
+        m_fl_bitmap |= 1u << fl;
+        m_sl_bitmaps[fl] |= 1u << sl;
+        m_stats.free_ranges++;
+    }
+
+    auto unlink(std::uint32_t index) noexcept -> void
+    {
+        const auto &node = m_nodes[index];
+        const auto [fl, sl] = mapping(node.size);
+
+        if (node.previous_free != NONE) { m_nodes[node.previous_free].next_free = node.next_free; }
+        if (node.next_free != NONE) { m_nodes[node.next_free].previous_free = node.previous_free; }
+        if (m_heads[fl][sl] == index) {
+            m_heads[fl][sl] = node.next_free;
+            if (node.next_free == NONE) {
+                m_sl_bitmaps[fl] &= ~(1u << sl);
+                if (m_sl_bitmaps[fl] == 0) { m_fl_bitmap &= ~(1u << fl); }
+            }
+        }
+        m_stats.free_ranges--;
+    }
+
+    auto createNode(const Node &node) -> std::uint32_t
+    {
+        if (m_unused.empty()) {
+            m_nodes.push_back(node);
+            return static_cast<std::uint32_t>(m_nodes.size() - 1);
+        }
+        const auto index = m_unused.back();
+        m_unused.pop_back();
+        m_nodes[index] = node;
+        return index;
+    }
+
+    auto removeNode(std::uint32_t index) -> void
+    {
+        m_nodes[index].block = NONE;
+        m_unused.push_back(index);
+    }
+
+    auto createBlock(std::size_t size) -> void
+    {
+        const auto buffer = m_pool.acquire(ObjectPool::Type::BUFFER);
+        CALL_OPEN_GL(
+            ::glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_STORAGE_BIT));
+        debug_label(GL_BUFFER, buffer, "BufferAllocator block");
+
+        auto block = static_cast<std::uint32_t>(m_blocks.size());
+        for (std::uint32_t i = 0; i != m_blocks.size(); i++) {
+            if (m_blocks[i].buffer == 0) { block = i; }
+        }
+        if (block == m_blocks.size()) { m_blocks.emplace_back(); }
+        m_blocks[block] = {buffer, size, 0, false};
+
+        insert(createNode({0, size, block, NONE, NONE, NONE, NONE, true}));
+        m_stats.blocks++;
+        m_stats.reserved += size;
+    }
+
+    // the block holds a single free node, which is not listed when the block is retired
+    auto removeBlock(std::uint32_t index) -> void
+    {
+        auto &block = m_blocks[index];
+        for (std::uint32_t i = 0; i != m_nodes.size(); i++) {
+            if (m_nodes[i].block != index) { continue; }
+            if (!block.retired) { unlink(i); }
+            removeNode(i);
+        }
+        m_pool.release(ObjectPool::Type::BUFFER, block.buffer);
+        m_stats.blocks--;
+        m_stats.reserved -= block.size;
+        block = {0, 0, 0, false};
+    }
+
+    // keep bytes in the node, the rest becomes a free node
+    auto split(std::uint32_t index, std::size_t bytes) -> void
+    {
+        if (m_nodes[index].size - bytes < GRANULARITY) { return; }
+
+        const auto &node = m_nodes[index];
+        const auto rest = createNode(
+            {node.offset + bytes, node.size - bytes, node.block, index, node.next, NONE, NONE, true});
+        auto &kept = m_nodes[index];
+        if (kept.next != NONE) { m_nodes[kept.next].previous = rest; }
+        kept.next = rest;
+        kept.size = bytes;
+        insert(rest);
+    }
+
+    // absorb the next node of index, both out of the free lists
+    auto merge(std::uint32_t index) -> void
+    {
+        const auto next = m_nodes[index].next;
+        auto &node = m_nodes[index];
+        node.size += m_nodes[next].size;
+        node.next = m_nodes[next].next;
+        if (node.next != NONE) { m_nodes[node.next].previous = index; }
+        removeNode(next);
+    }
+
+    auto free(std::uint32_t index) -> void
+    {
+        auto &block = m_blocks[m_nodes[index].block];
+        m_stats.used -= m_nodes[index].size;
+        m_stats.allocations--;
+        block.allocations--;
+        m_nodes[index].free = true;
+
+        // note : the free ranges of a retired block are not listed
+        if (const auto next = m_nodes[index].next; next != NONE && m_nodes[next].free) {
+            if (!block.retired) { unlink(next); }
+            merge(index);
+        }
+        if (const auto previous = m_nodes[index].previous; previous != NONE && m_nodes[previous].free) {
+            if (!block.retired) { unlink(previous); }
+            merge(previous);
+            index = previous;
+        }
+
+        if (!block.retired) { insert(index); }
+
+        // note : an empty block is kept when it is the last one, to avoid a new one at the next allocation
+        const auto blocks = std::count_if(m_blocks.begin(), m_blocks.end(), [](const auto &i) {
+            return i.buffer != 0 && !i.retired;
+        });
+        if (block.allocations == 0 && (block.retired || blocks > 1)) { removeBlock(m_nodes[index].block); }
+    }
+
+    ObjectPool &m_pool;
+
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_unused;
+    std::vector<Block> m_blocks;
+
+    std::uint32_t m_fl_bitmap{0};
+    std::array<std::uint32_t, FL_COUNT> m_sl_bitmaps{};
+    std::array<std::array<std::uint32_t, SL_COUNT>, FL_COUNT> m_heads{[] {
+        std::array<std::array<std::uint32_t, SL_COUNT>, FL_COUNT> heads{};
+        for (auto &i : heads) { i.fill(NONE); }
+        return heads;
+    }()};
+
+    std::vector<std::uint32_t> m_current;
+    std::deque<Frame> m_retired;
+
+    Stats m_stats{};
+};
+
+} // namespace api
+} // namespace engine
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace api {
+
+// Names of the GL objects created by batch and deleted by batch, stored in the context of the registry
+//
+// The names are handed out from a free list refilled BATCH at a time by a single glCreate* call.
+// A released name is queued with the objects of the current frame, advance() inserts a fence at the end
+// of the frame and the queues whose fence is signaled are deleted with a single glDelete* call per type,
+// so the destruction of entities never issues a driver call in the middle of the frame.
+class ObjectPool {
+public:
+    enum class Type : std::size_t { VERTEX_ARRAY, BUFFER };
+
+    static constexpr std::size_t TYPES{2};
+
+    static constexpr std::size_t BATCH{64};
+
+    struct Stats {
+        std::size_t created;  // names created since the start
+        std::size_t deleted;  // names deleted since the start
+        std::size_t calls;    // glCreate* and glDelete* calls since the start
+        std::size_t free;     // names created but not handed out
+        std::size_t pending;  // names released and waiting for their fence
+    };
+
+    ObjectPool() = default;
+
+    ~ObjectPool()
+    {
+        // note : the context is still current, the gpu may still read the objects but the driver defers it
+        for (auto &frame : m_retired) {
+            ::glDeleteSync(frame.fence);
+            remove(frame.names);
+        }
+        remove(m_current);
+        remove(m_free);
+    }
+
+    ObjectPool(const ObjectPool &) = delete;
+    ObjectPool &operator=(const ObjectPool &) = delete;
+
+    // the object is created but has no storage nor state, like the one of glCreate*
+    [[nodiscard]] auto acquire(Type type) -> unsigned int
+    {
+        auto &names = m_free[index(type)];
+        if (names.empty()) {
+            names.resize(BATCH);
+            switch (type) {
+            case Type::VERTEX_ARRAY:
+                CALL_OPEN_GL(::glCreateVertexArrays(static_cast<GLsizei>(BATCH), names.data()));
+                break;
+            case Type::BUFFER:
+                CALL_OPEN_GL(::glCreateBuffers(static_cast<GLsizei>(BATCH), names.data()));
+                break;
+            }
+            m_stats.created += BATCH;
+            m_stats.calls++;
+        }
+
+        const auto name = names.back();
+        names.pop_back();
+        return name;
+    }
+
+    // note : the object is deleted a few frames later, its name must not be used anymore
+    auto release(Type type, unsigned int name) -> void
+    {
+        if (name != 0) { m_current[index(type)].push_back(name); }
+    }
+
+    // called once per frame after the last draw call, delete the objects the gpu is done with
+    auto advance() -> void
+    {
+        if (!empty(m_current)) {
+            m_retired.push_back({::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), std::move(m_current)});
+            m_current = {};
+        }
+
+        // note : polled without flush, the fences are submitted with the next swap at the latest
+        while (!m_retired.empty()) {
+            auto &frame = m_retired.front();
+            if (::glClientWaitSync(frame.fence, 0, 0) == GL_TIMEOUT_EXPIRED) { break; }
+            ::glDeleteSync(frame.fence);
+            remove(frame.names);
+            m_retired.pop_front();
+        }
+
+        m_stats.free = 0;
+        m_stats.pending = 0;
+        for (std::size_t i = 0; i != TYPES; i++) {
+            m_stats.free += m_free[i].size();
+            m_stats.pending += m_current[i].size();
+            for (const auto &frame : m_retired) { m_stats.pending += frame.names[i].size(); }
+        }
+    }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    using Names = std::array<std::vector<unsigned int>, TYPES>;
+
+    struct Frame {
+        GLsync fence;
+        Names names;
+    };
+
+    static constexpr auto index(Type type) noexcept -> std::size_t { return static_cast<std::size_t>(type); }
+
+    static auto empty(const Names &names) noexcept -> bool
+    {
+        for (const auto &i : names) {
+            if (!i.empty()) { return false; }
+        }
+        return true;
+    }
+
+    auto remove(Names &names) -> void
+    {
+        auto &vertex_arrays = names[index(Type::VERTEX_ARRAY)];
+        if (!vertex_arrays.empty()) {
+            CALL_OPEN_GL(
+                ::glDeleteVertexArrays(static_cast<GLsizei>(vertex_arrays.size()), vertex_arrays.data()));
+            m_stats.calls++;
+        }
+
+        auto &buffers = names[index(Type::BUFFER)];
+        if (!buffers.empty()) {
+            CALL_OPEN_GL(::glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data()));
+            m_stats.calls++;
+        }
+
+        for (auto &i : names) {
+            m_stats.deleted += i.size();
+            i.clear();
+        }
+    }
+
+    Names m_free;
+    Names m_current;
+    std::deque<Frame> m_retired;
+
+    Stats m_stats{};
+};
+
+} // namespace api
+} // namespace engine
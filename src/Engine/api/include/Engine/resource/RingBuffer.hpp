@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <spdlog/spdlog.h>
+
+#include "Engine/helpers/debug.hpp"
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace api {
+
+// Persistently mapped buffer for the data written every frame, stored in the context of the registry
+//
+// The buffer is split in FRAMES regions, the allocations of a frame are taken linearly from its region.
+// Before a region is reused, the fence inserted at the end of the frame which used it is waited,
+// so the writes never race with the gpu and the driver never has to copy or synchronize implicitly.
+class RingBuffer {
+public:
+    static constexpr std::size_t FRAMES{3};
+
+    static constexpr std::size_t DEFAULT_ALIGNMENT{16};
+
+    struct Allocation {
+        void *data;
+        unsigned int buffer;
+        std::size_t offset;
+        std::size_t size;
+
+        [[nodiscard]] explicit operator bool() const noexcept { return data != nullptr; }
+    };
+
+    struct Stats {
+        std::size_t allocated;  // bytes allocated during the last frame
+        std::size_t overflows;  // allocations refused because the region was full
+        std::size_t stalls;     // frames where the cpu had to wait for the gpu
+        std::chrono::microseconds stall_time;
+    };
+
+    explicit RingBuffer(std::size_t frame_size) : m_frame_size{frame_size}
+    {
+        constexpr GLbitfield FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        CALL_OPEN_GL(::glCreateBuffers(1, &m_buffer));
+        debug_label(GL_BUFFER, m_buffer, "RingBuffer");
+        CALL_OPEN_GL(::glNamedBufferStorage(m_buffer, static_cast<GLsizeiptr>(size()), nullptr, FLAGS));
+        m_mapped = static_cast<std::byte *>(
+            ::glMapNamedBufferRange(m_buffer, 0, static_cast<GLsizeiptr>(size()), FLAGS));
+        if (!m_mapped) { spdlog::error("engine::api::RingBuffer: could not map the buffer"); }
+    }
+
+    ~RingBuffer()
+    {
+        for (auto &fence : m_fences) {
+            if (fence) { ::glDeleteSync(fence); }
+        }
+        CALL_OPEN_GL(::glUnmapNamedBuffer(m_buffer));
+        CALL_OPEN_GL(::glDeleteBuffers(1, &m_buffer));
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    // reserve size bytes in the region of the current frame, the returned allocation is empty if it is full
+    [[nodiscard]] auto allocate(std::size_t size, std::size_t alignment = DEFAULT_ALIGNMENT) -> Allocation
+    {
+        const auto head = (m_head + alignment - 1) / alignment * alignment;
+        if (!m_mapped || head + size > m_frame_size) {
+            m_stats.overflows++;
+            return {nullptr, m_buffer, 0, 0};
+        }
+        m_head = head + size;
+
+        const auto offset = m_frame * m_frame_size + head;
+        return {m_mapped + offset, m_buffer, offset, size};
+    }
+
+    // fence the region of the current frame and move to the next one, waiting for the gpu if it still uses it
+    auto advance() -> void
+    {
+        m_fences[m_frame] = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_stats.allocated = m_head;
+
+        m_frame = (m_frame + 1) % FRAMES;
+        m_head = 0;
+
+        auto &fence = m_fences[m_frame];
+        if (!fence) { return; }
+
+        if (::glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            constexpr GLuint64 TIMEOUT_NS{1'000'000};
+
+            const auto start = std::chrono::steady_clock::now();
+            while (::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT_NS) == GL_TIMEOUT_EXPIRED) {}
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            m_stats.stalls++;
+            m_stats.stall_time += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+        }
+        ::glDeleteSync(fence);
+        fence = nullptr;
+    }
+
+    [[nodiscard]] auto getBuffer() const noexcept { return m_buffer; }
+
+    [[nodiscard]] auto getFrameSize() const noexcept { return m_frame_size; }
+
+    [[nodiscard]] auto size() const noexcept { return m_frame_size * FRAMES; }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    unsigned int m_buffer{0};
+    std::byte *m_mapped{nullptr};
+
+    std::size_t m_frame_size;
+    std::size_t m_frame{0};
+    std::size_t m_head{0};
+
+    std::array<GLsync, FRAMES> m_fences{};
+
+    Stats m_stats{};
+};
+
+} // namespace api
+} // namespace engine
@@ -14,6 +14,22 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 
+#include "engine_api_export.h"
+
+namespace engine::core {
+
+// How the GL errors are reported, the callbacks need KHR_debug (core since OpenGL 4.3)
+enum class DebugOutput {
+    POLL,         // glGetError after every CALL_OPEN_GL in debug builds, nothing in release builds
+    SYNCHRONOUS,  // message callback called by the faulty call itself, a breakpoint shows the call site
+    ASYNCHRONOUS, // message callback called whenever the driver wants, possibly from another thread
+};
+
+// note : set once by the core after the creation of the context, shared with the modules
+extern ENGINE_API_EXPORT DebugOutput debug_output;
+
+} // namespace engine::core
+
 #ifndef NDEBUG
 
 #    include <stdexcept>
@@ -42,16 +58,18 @@ inline constexpr auto GetGLErrorStr(GLenum err)
             spdlog::error("CALL_OPEN_GL: {}", engine::core::GetGLErrorStr(err)); \
         } while (0)
 
-#    define CALL_OPEN_GL(call)                                                  \
-        do {                                                                    \
-            call;                                                               \
-            if (const auto err = ::glGetError(); GL_NO_ERROR != err) {          \
-                if constexpr (!noexcept(__func__)) {                            \
-                    throw std::runtime_error(engine::core::GetGLErrorStr(err)); \
-                } else {                                                        \
-                    SHOW_ERROR(err);                                            \
-                }                                                               \
-            }                                                                   \
+// note : glGetError synchronizes with the driver, with a message callback installed the call is left alone
+#    define CALL_OPEN_GL(call)                                                                 \
+        do {                                                                                   \
+            call;                                                                              \
+            if (engine::core::debug_output != engine::core::DebugOutput::POLL) { break; }      \
+            if (const auto err = ::glGetError(); GL_NO_ERROR != err) {                         \
+                if constexpr (!noexcept(__func__)) {                                           \
+                    throw std::runtime_error(engine::core::GetGLErrorStr(err));                \
+                } else {                                                                       \
+                    SHOW_ERROR(err);                                                           \
+                }                                                                              \
+            }                                                                                  \
         } while (0)
 
 #else
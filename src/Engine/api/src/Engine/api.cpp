@@ -1 +1,4 @@
 #include "Engine/api.hpp"
+#include "Engine/third_party.hpp"
+
+engine::core::DebugOutput engine::core::debug_output{engine::core::DebugOutput::POLL};
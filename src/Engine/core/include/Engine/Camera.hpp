@@ -22,7 +22,11 @@ struct Camera {
 
     constexpr auto getProjectionType() const noexcept { return projection_type; }
 
-    auto setProjectionType(ProjectionType value) noexcept -> void { projection_type = value; }
+    auto setProjectionType(ProjectionType value) noexcept -> void
+    {
+        projection_type = value;
+        setChangedFlag<Matrix::PROJECTION>(true);
+    }
 
     auto getProjection() -> glm::mat4
     {
@@ -36,6 +40,8 @@ struct Camera {
         return glm::perspective(glm::radians(m_fov), m_window.getAspectRatio<float>(), m_near, m_far);
     };
 
+    auto getView() const -> glm::mat4 { return glm::lookAt(position, target_center, up); }
+
     constexpr auto getPosition() const noexcept -> const glm::vec3 & { return position; }
 
     auto getPosition() noexcept -> glm::vec3 & { return position; }
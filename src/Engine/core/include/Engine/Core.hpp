@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 
 #include <entt/entt.hpp>
 
@@ -9,7 +10,13 @@
 #include "Engine/EventManager.hpp"
 #include "Engine/dll/Handle.hpp"
 #include "Engine/graphics/Window.hpp"
+#include "Engine/graphics/FramePacer.hpp"
 #include "Engine/graphics/Shader.hpp"
+#include "Engine/graphics/RenderQueue.hpp"
+#include "Engine/graphics/StateTracker.hpp"
+#include "Engine/system/CullingSystem.hpp"
+#include "Engine/system/OcclusionSystem.hpp"
+#include "Engine/Camera.hpp"
 
 namespace engine {
 namespace core {
@@ -23,14 +30,39 @@ public:
 
     auto getEventManager() -> EventManager & { return m_event_manager; }
 
+    enum class RenderingMode {
+        DIRECT,    // one draw call per entity
+        INSTANCED, // one draw call per mesh
+        INDIRECT,  // one multi draw indirect call per display mode
+    };
+
+    // api used by GLFW to create the OpenGL context
+    enum class ContextAPI {
+        NATIVE, // GLX, WGL or NSGL, OSMesa on the null platform
+        EGL,    // surfaceless on the null platform (EGL_MESA_platform_surfaceless), e.g. Mesa llvmpipe
+        OSMESA, // pure software rendering
+    };
+
 private:
     auto load_module(const std::string_view) -> const api::Module *;
-    auto initialize_graphics(int glfw_context_major, int glfw_context_minor) -> bool;
+    auto initialize_graphics(
+        int glfw_context_major,
+        int glfw_context_minor,
+        ContextAPI context_api,
+        DebugOutput gl_debug,
+        bool headless) -> bool;
 
     auto loop() -> void;
 
 private:
-    auto system_rendering(Shader &, /* const */ entt::registry &) const noexcept;
+    auto system_rendering(
+        Shader &,
+        /* const */ entt::registry &,
+        const Camera &,
+        const CullingSystem &,
+        OcclusionSystem &,
+        RenderQueue &,
+        StateTracker &) const;
 
 private:
     entt::resource_cache<dll::Handle> m_cache_module_handle;
@@ -40,6 +72,16 @@ private:
 
     bool m_is_running{false};
 
+    RenderingMode m_rendering_mode{RenderingMode::DIRECT};
+
+    std::string m_profile_csv{}; // empty when the timings are not written
+
+    double m_max_fps{0.0}; // 0 when unlimited
+    FramePacer::VSync m_vsync{FramePacer::VSync::ADAPTIVE};
+    std::size_t m_frames_in_flight{2};
+
+    double m_defragment_threshold{0.5}; // 0 when the mesh buffers are never compacted
+
     std::unique_ptr<Window> m_window{};
 
     EventManager m_event_manager;
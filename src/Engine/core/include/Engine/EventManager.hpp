@@ -78,7 +78,8 @@ private:
 
     auto fetchEvent() -> api::Event
     {
-        ::glfwPollEvents();
+        // note : the events already buffered are handed out first, the window system is polled once per frame
+        if (m_buffer_events.empty()) { ::glfwPollEvents(); }
 
         if (m_buffer_events.empty()) {
             return api::TimeElapsed{std::chrono::nanoseconds{
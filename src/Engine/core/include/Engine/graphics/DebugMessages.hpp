@@ -0,0 +1,15 @@
+#pragma once
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace core {
+
+// Install the KHR_debug message callback logging the GL errors and warnings, then set debug_output
+//
+// The notifications and the debug group messages are filtered out, they are only noise in the log.
+// note : returns the mode actually used, POLL when the context does not support KHR_debug
+auto install_debug_messages(DebugOutput mode) -> DebugOutput;
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+
+#include "Engine/third_party.hpp"
+#include "Engine/graphics/GpuProfiler.hpp"
+
+namespace engine {
+namespace core {
+
+// Pace the frames to a target rate and bound the number of frames queued on the gpu
+//
+// Once a frame is submitted, the fence of the frame issued frames in flight ago is waited, so the cpu never
+// runs further ahead of the gpu and the input latency stays bounded. Then the thread waits for the start of
+// the next period : it sleeps while the time left is above the estimated oversleep, and spins for the rest,
+// a sleep alone being too coarse (1 ms at best, up to 15 ms on some systems) to hit the deadline.
+class FramePacer {
+public:
+    static constexpr std::size_t HISTORY{GpuProfiler::HISTORY};
+    static constexpr std::size_t MAX_FRAMES_IN_FLIGHT{4};
+    static constexpr double IDLE_FPS{10.0}; // target while the window is minimized
+
+    enum class VSync {
+        OFF,      // present as soon as possible, may tear
+        ON,       // wait for the vertical blank
+        ADAPTIVE, // wait for the vertical blank unless the frame is late, ON when the driver lacks it
+    };
+
+    struct Stats {
+        std::chrono::microseconds slept;      // during the last frame
+        std::chrono::microseconds spun;       // during the last frame
+        std::chrono::microseconds fence_wait; // during the last frame
+        std::size_t fence_stalls;             // frames which waited for the gpu, in total
+        std::size_t missed;                   // frames which ended after their deadline, in total
+        double jitter;                        // standard deviation of the frame times in the history, in ms
+    };
+
+    // note : 0 fps means unlimited, frames in flight is clamped in [1, MAX_FRAMES_IN_FLIGHT]
+    FramePacer(double max_fps, std::size_t frames_in_flight);
+    ~FramePacer();
+
+    FramePacer(const FramePacer &) = delete;
+    FramePacer &operator=(const FramePacer &) = delete;
+
+    // set the swap interval of the current context, returns the mode applied
+    auto setVSync(VSync vsync) -> VSync;
+
+    [[nodiscard]] auto getVSync() const noexcept { return m_vsync; }
+
+    auto setMaxFps(double fps) noexcept -> void { m_max_fps = fps; }
+
+    [[nodiscard]] auto getMaxFps() const noexcept { return m_max_fps; }
+
+    // note : the idle rate only applies when it is lower than the max fps
+    auto setIdle(bool idle) noexcept -> void { m_idle = idle; }
+
+    [[nodiscard]] auto getFramesInFlight() const noexcept { return m_frames_in_flight; }
+
+    // to be called once the frame is submitted, waits for the gpu then for the next period
+    auto endFrame() -> void;
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+    // the duration in ms of the last HISTORY frames, index (samples % HISTORY) is the oldest
+    [[nodiscard]] auto getFrameTimes() const noexcept -> const std::array<float, HISTORY> &
+    {
+        return m_times;
+    }
+    [[nodiscard]] auto getCount() const noexcept { return std::min(m_samples, HISTORY); }
+    [[nodiscard]] auto getOffset() const noexcept
+    {
+        return m_samples < HISTORY ? std::size_t{0} : m_samples % HISTORY;
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    auto waitGpu() -> void;
+
+    auto waitDeadline(clock::time_point deadline) -> void;
+
+    auto record(clock::duration frame) -> void;
+
+    double m_max_fps;
+    VSync m_vsync{VSync::OFF};
+    bool m_idle{false};
+
+    std::size_t m_frames_in_flight;
+    std::array<GLsync, MAX_FRAMES_IN_FLIGHT> m_fences{};
+    std::size_t m_frame{0};
+
+    clock::time_point m_deadline{clock::now()};
+    clock::time_point m_last{clock::now()};
+
+    // note : exponentially weighted mean and variance of the duration of a 1 ms sleep, in ms
+    double m_sleep_mean{1.0};
+    double m_sleep_variance{0.0};
+
+    std::array<float, HISTORY> m_times{};
+    std::size_t m_samples{0};
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "Engine/third_party.hpp"
+#include "Engine/graphics/ImageEncoder.hpp"
+
+namespace engine {
+namespace core {
+
+// Copy the framebuffer into a rotating set of pixel buffers, mapped once the GPU is done with them
+class FrameReadback {
+public:
+    static constexpr std::size_t SLOTS{3};
+
+    FrameReadback();
+    ~FrameReadback();
+
+    FrameReadback(const FrameReadback &) = delete;
+    FrameReadback &operator=(const FrameReadback &) = delete;
+
+    // start the copy of a region of the bound read framebuffer, false when every slot is still in flight
+    auto read(int x, int y, int width, int height, std::string filename, ImageEncoder::Format format) -> bool;
+
+    // hand the finished copies to the encoder, never waits for the GPU
+    auto poll(ImageEncoder &encoder) -> void;
+
+    // hand the oldest copy to the encoder, waiting for the GPU if needed, so a slot is free again
+    auto reclaim(ImageEncoder &encoder) -> void;
+
+    // hand every copy to the encoder, waiting for the GPU if needed
+    // note : the context must still be current, the copies which cannot complete are logged and dropped
+    auto flush(ImageEncoder &encoder) -> void;
+
+    // number of copies never handed to the encoder
+    [[nodiscard]] auto getDropped() const noexcept { return m_dropped; }
+
+private:
+    struct Slot {
+        GLuint buffer;
+        std::size_t capacity;
+        GLsync fence;
+        std::size_t sequence; // order of the requests, the oldest copies are handed first
+        int width;
+        int height;
+        std::string filename;
+        ImageEncoder::Format format;
+    };
+
+    auto collect(ImageEncoder &encoder, GLuint64 timeout, std::size_t limit = SLOTS) -> void;
+
+    auto resolve(Slot &slot, ImageEncoder &encoder) -> void;
+
+    auto drop(Slot &slot, const std::string_view reason) -> void;
+
+    std::array<Slot, SLOTS> m_slots{};
+    std::size_t m_sequence{0};
+    std::size_t m_dropped{0};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace core {
+
+struct Camera;
+
+// Uniform buffer holding the per-frame camera data, shared by every Shader
+class FrameUniforms {
+public:
+    // name of the uniform block, bound to BINDING by Shader when linked
+    static constexpr auto BLOCK_NAME = "Frame";
+    static constexpr GLuint BINDING{0};
+
+    // std140 layout of the block :
+    // layout (std140) uniform Frame {
+    //     mat4 view;
+    //     mat4 projection;
+    //     mat4 view_projection;
+    //     vec4 camera_position;
+    //     float time;
+    // };
+    struct Block {
+        glm::mat4 view;
+        glm::mat4 projection;
+        glm::mat4 view_projection;
+        glm::vec4 camera_position;
+        float time;
+        float padding[3];
+    };
+
+    FrameUniforms();
+    ~FrameUniforms();
+
+    FrameUniforms(const FrameUniforms &) = delete;
+    FrameUniforms &operator=(const FrameUniforms &) = delete;
+
+    // upload the block once for the frame, the matrices are only recomputed when the camera changed
+    auto update(Camera &camera, float time) -> void;
+
+    [[nodiscard]] constexpr auto getBlock() const noexcept -> const Block & { return m_block; }
+
+private:
+    GLuint m_buffer{0};
+
+    Block m_block{};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+
+#include <glm/glm.hpp>
+
+namespace engine {
+namespace core {
+
+// Planes of the view volume, extracted from a view projection matrix
+class Frustum {
+public:
+    enum class Result {
+        OUTSIDE,
+        INTERSECT,
+        INSIDE,
+    };
+
+    explicit Frustum(const glm::mat4 &view_projection) noexcept;
+
+    // the 6 planes are tested at once, 4 by 4 when SSE is available
+    [[nodiscard]] auto classify(const glm::vec3 &min, const glm::vec3 &max) const noexcept -> Result;
+
+private:
+    // note : structure of arrays padded to 8 planes, the padding planes contain everything
+    static constexpr auto PLANES = 8ul;
+
+    alignas(16) std::array<float, PLANES> m_x{};
+    alignas(16) std::array<float, PLANES> m_y{};
+    alignas(16) std::array<float, PLANES> m_z{};
+    alignas(16) std::array<float, PLANES> m_w{};
+};
+
+} // namespace core
+} // namespace engine
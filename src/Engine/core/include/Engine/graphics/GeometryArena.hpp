@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include <entt/entt.hpp>
+
+#include <Engine/component/all.hpp>
+
+namespace engine {
+namespace core {
+
+// Shared vertex / index buffers holding the meshes of the entities, so they can be drawn from a single VAO
+//
+// The meshes are copied from api::Vertices / api::EBO the first time their content hash is seen. The vertices
+// are stored in LAYOUT, copied on the gpu when the entity uses it and converted on the cpu otherwise.
+// The normals are dropped, the indices are uint32.
+// note : the arena only grows, the meshes are never released
+class GeometryArena {
+public:
+    static constexpr GLuint BINDING{0};
+
+    // note : 16 bytes per vertex, the positions are kept in full precision
+    static constexpr api::VertexLayout LAYOUT{
+        api::VertexLayout::Format::FLOAT32,
+        api::VertexLayout::Format::UNORM8,
+        api::VertexLayout::Format::NONE};
+
+    // location in the arena, in the units of glDrawElementsBaseVertex
+    struct Mesh {
+        GLuint first_index;
+        GLuint index_count;
+        GLint base_vertex;
+    };
+
+    struct Stats {
+        std::size_t meshes;
+        std::size_t vertices;
+        std::size_t indices;
+    };
+
+    GeometryArena();
+    ~GeometryArena();
+
+    GeometryArena(const GeometryArena &) = delete;
+    GeometryArena &operator=(const GeometryArena &) = delete;
+
+    // return the mesh of the entity, nullptr if it has no vertices
+    auto import(const entt::registry &world, entt::entity entity) -> const Mesh *;
+
+    [[nodiscard]] auto getVAO() const noexcept { return m_vao; }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    // a buffer growing by doubling its capacity, the previous content is copied on the gpu
+    struct Stream {
+        std::string_view label; // debug label of the buffer, given again each time it grows
+        GLuint buffer{0};
+        std::size_t size{0};
+        std::size_t capacity{0};
+
+        // reserve bytes at the end of the stream, return the offset
+        auto allocate(std::size_t bytes) -> std::size_t;
+    };
+
+    auto bind() -> void;
+
+    GLuint m_vao{0};
+
+    Stream m_vertices{"GeometryArena vertices"};
+    Stream m_indices{"GeometryArena indices"};
+
+    std::unordered_map<std::uint64_t, std::optional<Mesh>> m_meshes;
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
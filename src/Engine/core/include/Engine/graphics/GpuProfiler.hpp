@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace core {
+
+// Measure named sections of the frame on the CPU and on the GPU, the GPU results are read a few frames late
+class GpuProfiler {
+public:
+    static constexpr std::size_t LATENCY{3}; // frames between the queries and the read of their results
+    static constexpr std::size_t HISTORY{240};
+
+    struct Summary {
+        double min;
+        double avg;
+        double p99;
+    };
+
+    // the timings in milliseconds of the last HISTORY frames, index (samples % HISTORY) is the oldest
+    struct Section {
+        std::string name;
+        std::array<float, HISTORY> cpu;
+        std::array<float, HISTORY> gpu;
+        std::size_t samples;
+
+        [[nodiscard]] auto getCount() const noexcept { return std::min(samples, HISTORY); }
+        [[nodiscard]] auto getOffset() const noexcept
+        {
+            return samples < HISTORY ? std::size_t{0} : samples % HISTORY;
+        }
+    };
+
+    // note : timestamps are used instead of GL_TIME_ELAPSED so the scopes can be nested
+    // note : each scope is also a debug group named after its section
+    class Scope {
+    public:
+        Scope(GpuProfiler &profiler, std::size_t section);
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        GpuProfiler &m_profiler;
+        std::size_t m_section;
+        api::DebugGroup m_group;
+        GLuint m_begin;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    // note : an empty path disables the CSV output
+    explicit GpuProfiler(const std::filesystem::path &csv = {});
+    ~GpuProfiler();
+
+    GpuProfiler(const GpuProfiler &) = delete;
+    GpuProfiler &operator=(const GpuProfiler &) = delete;
+
+    // read the results of the frame issued LATENCY frames ago, never waits for the GPU
+    auto beginFrame() -> void;
+
+    [[nodiscard]] auto scope(std::string_view name) -> Scope;
+
+    [[nodiscard]] auto getSections() const noexcept -> const std::vector<Section> & { return m_sections; }
+
+    // results which were not available in time and were dropped
+    [[nodiscard]] auto getDropped() const noexcept { return m_dropped; }
+
+    [[nodiscard]] static auto summarize(const std::array<float, HISTORY> &values, std::size_t count)
+        -> Summary;
+
+private:
+    struct Record {
+        std::size_t section;
+        GLuint begin;
+        GLuint end;
+        float cpu;
+    };
+
+    auto acquire() -> GLuint;
+
+    auto resolve(std::vector<Record> &records) -> void;
+
+    std::vector<Section> m_sections;
+
+    std::array<std::vector<Record>, LATENCY> m_frames;
+    std::size_t m_frame{0};
+
+    std::vector<GLuint> m_pool;
+    std::size_t m_dropped{0};
+
+    std::ofstream m_csv;
+};
+
+} // namespace core
+} // namespace engine
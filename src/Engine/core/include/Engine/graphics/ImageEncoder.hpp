@@ -0,0 +1,87 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace engine {
+namespace core {
+
+// Write the captured images to disk on a pool of background threads, away from the rendering loop
+class ImageEncoder {
+public:
+    enum class Format {
+        PNG, // compressed, slow to encode
+        QOI, // lossless, a few times faster than PNG
+        RAW, // RGBA8 bytes as is, the size is only known from the recording index
+    };
+
+    // RGBA8 pixels, the first row is the top of the image
+    struct Image {
+        std::string filename;
+        Format format;
+        int width;
+        int height;
+        std::vector<char> pixels;
+    };
+
+    struct Stats {
+        std::size_t encoded;
+        std::size_t failed;
+        std::size_t peak;                 // highest number of images waiting in the queue
+        std::size_t stalls;               // times push had to wait for a free place in the queue
+        std::chrono::nanoseconds stalled; // total time spent waiting in push
+    };
+
+    static constexpr std::size_t DEFAULT_CAPACITY{8};
+
+    // note : 0 worker picks half of the hardware threads, the other half is left to the rendering
+    explicit ImageEncoder(std::size_t workers = 0, std::size_t capacity = DEFAULT_CAPACITY);
+    // note : the queued images are all written before the workers are joined
+    ~ImageEncoder();
+
+    ImageEncoder(const ImageEncoder &) = delete;
+    ImageEncoder &operator=(const ImageEncoder &) = delete;
+
+    // blocks while the queue is full, nothing is ever dropped
+    auto push(Image &&image) -> void;
+
+    [[nodiscard]] auto getPending() const -> std::size_t;
+
+    [[nodiscard]] auto getStats() const -> Stats;
+
+    [[nodiscard]] static constexpr auto extension(Format format) noexcept -> const char *
+    {
+        switch (format) {
+        case Format::PNG: return "png";
+        case Format::QOI: return "qoi";
+        case Format::RAW: return "rgba";
+        }
+        return "";
+    }
+
+private:
+    auto run() -> void;
+
+    static auto encode(const Image &image) -> bool;
+
+    const std::size_t m_capacity;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_not_empty;
+    std::condition_variable m_not_full;
+    std::deque<Image> m_queue;
+    bool m_stop{false};
+
+    Stats m_stats{};
+
+    std::vector<std::thread> m_workers;
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/graphics/GeometryArena.hpp"
+#include "Engine/graphics/Shader.hpp"
+#include "Engine/graphics/StaticBatcher.hpp"
+#include "Engine/system/CullingSystem.hpp"
+#include "Engine/system/TransformSystem.hpp"
+
+namespace engine {
+namespace core {
+
+// Draw the entities from the GeometryArena with one glMultiDrawElementsIndirect per display mode
+//
+// The entities sharing a mesh are merged in one command, the per-draw data is read from a storage buffer
+// indexed by an instanced attribute holding the sequence 0, 1, 2 ... offset by the base instance.
+class IndirectRenderer {
+public:
+    static constexpr GLuint ATTRIBUTE_DRAW{3};
+    static constexpr GLuint BINDING_DRAW{2};
+
+    // binding point of the shader storage buffer holding the DrawData
+    static constexpr GLuint DRAW_DATA_BINDING{1};
+
+    // layout of DrawElementsIndirectCommand
+    struct Command {
+        GLuint count;
+        GLuint instance_count;
+        GLuint first_index;
+        GLint base_vertex;
+        GLuint base_instance;
+    };
+
+    // std430 layout
+    struct DrawData {
+        glm::vec4 tint;
+        std::uint32_t transform;
+        std::uint32_t padding[3];
+    };
+
+    struct Stats {
+        std::size_t multi_draws;
+        std::size_t commands;
+        std::size_t draws;
+        std::size_t rejected;
+    };
+
+    IndirectRenderer();
+    ~IndirectRenderer();
+
+    IndirectRenderer(const IndirectRenderer &) = delete;
+    IndirectRenderer &operator=(const IndirectRenderer &) = delete;
+
+    auto draw(
+        entt::registry &world,
+        const TransformSystem &transforms,
+        const CullingSystem &culling,
+        StateTracker &state) -> void;
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+    [[nodiscard]] auto getArena() const noexcept -> const GeometryArena & { return m_arena; }
+
+private:
+    struct Entry {
+        api::VAO::DisplayMode mode;
+        const GeometryArena::Mesh *mesh;
+        DrawData data;
+    };
+
+    // consecutive commands of the same mode, submitted in one call
+    struct Range {
+        api::VAO::DisplayMode mode;
+        std::size_t first;
+        GLsizei count;
+    };
+
+    Shader m_shader;
+
+    GeometryArena m_arena;
+
+    GLuint m_command_buffer{0};
+    GLuint m_draw_buffer{0};
+
+    // sequence 0, 1, 2 ... read by ATTRIBUTE_DRAW
+    GLuint m_sequence_buffer{0};
+    std::size_t m_sequence_size{0};
+
+    std::vector<Entry> m_entries;
+    std::vector<Command> m_commands;
+    std::vector<DrawData> m_draws;
+    std::vector<Range> m_ranges;
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/component/all.hpp>
+#include <Engine/resource/RingBuffer.hpp>
+
+#include "Engine/graphics/Shader.hpp"
+#include "Engine/graphics/StaticBatcher.hpp"
+#include "Engine/system/CullingSystem.hpp"
+#include "Engine/system/LODSystem.hpp"
+#include "Engine/system/TransformSystem.hpp"
+
+namespace engine {
+namespace core {
+
+// Group the entities drawing the same mesh and submit them in one instanced draw call
+class InstancedRenderer {
+public:
+    // the per-instance attributes are placed after the ones of api::VAO::Attribute
+    static constexpr GLuint ATTRIBUTE_TRANSFORM{3}; // slot of the world matrix in the TransformSystem buffer
+    static constexpr GLuint ATTRIBUTE_TINT{4};
+    static constexpr GLuint INSTANCE_BINDING{ATTRIBUTE_TRANSFORM};
+
+    struct Instance {
+        glm::vec4 tint;
+        std::uint32_t transform;
+    };
+
+    struct Stats {
+        std::size_t draw_calls;
+        std::size_t instances;
+    };
+
+    explicit InstancedRenderer(entt::registry &world);
+    ~InstancedRenderer();
+
+    InstancedRenderer(const InstancedRenderer &) = delete;
+    InstancedRenderer &operator=(const InstancedRenderer &) = delete;
+
+    auto draw(
+        entt::registry &world,
+        const TransformSystem &transforms,
+        const CullingSystem &culling,
+        api::RingBuffer &ring,
+        StateTracker &state) -> void;
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    struct Key {
+        std::uint64_t content_hash;
+        api::VAO::DisplayMode mode;
+        GLsizei first; // the level of detail of the mesh is part of the key
+        GLsizei count;
+        bool has_ebo;
+
+        auto operator==(const Key &) const -> bool = default;
+    };
+
+    struct KeyHash {
+        auto operator()(const Key &key) const noexcept -> std::size_t
+        {
+            const auto range = api::hash_bytes(&key.first, sizeof(key.first), key.content_hash);
+            return static_cast<std::size_t>(api::hash_bytes(&key.count, sizeof(key.count), range))
+                   ^ (static_cast<std::size_t>(key.mode) << 1u) ^ static_cast<std::size_t>(key.has_ebo);
+        }
+    };
+
+    struct Batch {
+        Key key;
+        GLuint vao;
+        std::vector<Instance> instances;
+    };
+
+    auto on_destroy_vao(entt::registry &world, entt::entity entity) -> void;
+
+    entt::registry &m_world;
+
+    Shader m_shader;
+
+    GLuint m_instance_buffer{0};
+
+    std::unordered_map<Key, std::size_t, KeyHash> m_batch_index;
+    std::vector<Batch> m_batches;
+    std::vector<Instance> m_upload; // only used when the ring buffer is full
+
+    // VAO which already have the instance attributes format set up
+    std::unordered_set<GLuint> m_configured;
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace engine {
+namespace core {
+
+// Depth buffer rasterized on the cpu from the occluders, reduced in a hierarchical-Z pyramid to test bounds
+//
+// The depth is the normalized device z remapped in [0, 1]. Each level of the pyramid keeps the farthest depth
+// of the 2x2 texels below, so a box is hidden when its nearest point is behind every texel it covers.
+// The buffer is split in bands of BAND_HEIGHT rows which are rasterized and reduced independently, so they
+// can run on different threads. No OpenGL call is made.
+class OcclusionBuffer {
+public:
+    static constexpr std::size_t WIDTH{256};
+    static constexpr std::size_t HEIGHT{128};
+    static constexpr std::size_t LEVELS{5};
+    static constexpr std::size_t BAND_HEIGHT{std::size_t{1} << (LEVELS - 1)};
+    static constexpr std::size_t BANDS{HEIGHT / BAND_HEIGHT};
+
+    static_assert(WIDTH % (4 << (LEVELS - 1)) == 0 && HEIGHT % BAND_HEIGHT == 0);
+
+    OcclusionBuffer();
+
+    // drop the triangles of the previous frame
+    auto begin(const glm::mat4 &view_projection) -> void;
+
+    // transform the triangles of a mesh, clip them against the near plane and keep the ones on the screen
+    auto addMesh(
+        const glm::mat4 &model, std::span<const glm::vec3> positions, std::span<const std::uint32_t> indices)
+        -> void;
+
+    // clear the band, rasterize the triangles overlapping it then reduce it in the pyramid
+    // note : the bands can be rasterized concurrently once every mesh has been added
+    auto rasterize(std::size_t band) -> void;
+
+    // false when the local box transformed by model is hidden, every band must have been rasterized
+    [[nodiscard]] auto
+        isVisible(const glm::vec3 &min, const glm::vec3 &max, const glm::mat4 &model) const noexcept -> bool;
+
+    [[nodiscard]] auto getTriangleCount() const noexcept { return m_triangles.size(); }
+
+    // the first row is the bottom of the screen
+    [[nodiscard]] auto getLevel(std::size_t level) const noexcept -> std::span<const float>
+    {
+        return m_levels[level];
+    }
+
+private:
+    // in pixels, the depth in z
+    struct Triangle {
+        std::array<glm::vec3, 3> vertices;
+        std::int32_t min_x;
+        std::int32_t max_x;
+        std::int32_t min_y;
+        std::int32_t max_y;
+    };
+
+    auto addTriangle(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c) -> void;
+
+    auto rasterize(const Triangle &triangle, std::int32_t first_row, std::int32_t last_row) noexcept -> void;
+
+    glm::mat4 m_view_projection{1.0f};
+
+    std::vector<Triangle> m_triangles;
+
+    std::array<std::vector<float>, LEVELS> m_levels;
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace core {
+
+// Binaries of the linked programs kept on disk, keyed by their sources and by the driver which produced them
+class ProgramCache {
+public:
+    struct Stats {
+        std::size_t hits;
+        std::size_t misses;
+        std::size_t rejected; // binaries refused by the driver, e.g. after an update
+        std::chrono::nanoseconds load_time;
+        std::chrono::nanoseconds compile_time;
+    };
+
+    // note : the Shaders are created everywhere in the engine, they all share this cache
+    static auto get() noexcept -> ProgramCache &
+    {
+        static ProgramCache instance;
+        return instance;
+    }
+
+    // an empty directory disables the cache
+    auto setDirectory(const std::filesystem::path &directory) -> void { m_directory = directory; }
+
+    // hash of the sources, of the vendor, renderer and version strings of the driver
+    [[nodiscard]] auto key(std::initializer_list<std::string_view> sources) -> std::uint64_t;
+
+    // link the program from the binary stored under key, false when it has to be compiled
+    auto load(GLuint program, std::uint64_t key) -> bool;
+
+    // note : the program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+    auto store(GLuint program, std::uint64_t key) -> void;
+
+    auto addCompileTime(std::chrono::nanoseconds duration) noexcept -> void
+    {
+        m_stats.compile_time += duration;
+    }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+    auto log() const -> void;
+
+private:
+    ProgramCache() = default;
+
+    [[nodiscard]] auto isEnabled() -> bool;
+
+    [[nodiscard]] auto path(std::uint64_t key) const -> std::filesystem::path;
+
+    std::filesystem::path m_directory;
+
+    // driver strings hash, computed once a context exists
+    std::optional<std::uint64_t> m_driver;
+
+    // formats accepted by glProgramBinary, note : a driver without any cannot use the cache
+    std::optional<std::vector<GLint>> m_formats;
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/graphics/Shader.hpp"
+#include "Engine/graphics/StateTracker.hpp"
+
+namespace engine {
+namespace core {
+
+// Collect the draws of a frame, sort them by a 64 bits key and submit them with the fewest state changes
+//
+// layout of the key, from the most significant bit :
+//  SOLID       | pass : 2 | program : 12 | depth : 24 (front to back) | mesh : 24 | unused : 2
+//  TRANSLUCENT | pass : 2 | depth : 24 (back to front) | program : 12 | mesh : 24 | unused : 2
+//
+// The mesh is the content hash of the VAO, the draws of the same mesh at the same depth are kept together.
+class RenderQueue {
+public:
+    enum class Pass : std::uint8_t {
+        SOLID,       // drawn first, front to back
+        TRANSLUCENT, // blended, back to front
+    };
+
+    struct Draw {
+        Shader *shader;
+        GLuint vao;
+        api::VAO::DisplayMode mode;
+        GLsizei first; // first index, or first vertex when not indexed
+        GLsizei count;
+        bool indexed;
+        entt::entity entity;
+    };
+
+    // depth is normalized in [0, 1], 0 being the closest to the camera, mesh is api::VAO::content_hash
+    [[nodiscard]] static auto makeKey(Pass pass, GLuint program, std::uint64_t mesh, float depth) noexcept
+        -> std::uint64_t;
+
+    auto clear() noexcept -> void
+    {
+        m_draws.clear();
+        m_items.clear();
+    }
+
+    auto push(Pass pass, float depth, std::uint64_t mesh, const Draw &draw) -> void
+    {
+        m_items.push_back({makeKey(pass, draw.shader->getID(), mesh, depth), m_draws.size()});
+        m_draws.push_back(draw);
+    }
+
+    // radix sort of the keys
+    auto sort() -> void;
+
+    // submit the draws in key order, prepare is called with the Draw before each draw call
+    template<typename Prepare>
+    auto submit(StateTracker &state, Prepare &&prepare) -> std::size_t
+    {
+        for (const auto &item : m_items) {
+            const auto &draw = m_draws[item.index];
+            draw.shader->use(state);
+            state.bindVertexArray(draw.vao);
+            prepare(draw);
+            const auto mode = static_cast<GLenum>(draw.mode);
+            if (draw.indexed) {
+                state.drawElements(mode, draw.count, static_cast<std::size_t>(draw.first));
+            } else {
+                state.drawArrays(mode, draw.first, draw.count);
+            }
+        }
+        return m_items.size();
+    }
+
+    [[nodiscard]] auto size() const noexcept { return m_items.size(); }
+
+private:
+    struct Item {
+        std::uint64_t key;
+        std::size_t index;
+    };
+
+    std::vector<Draw> m_draws;
+    std::vector<Item> m_items;
+    std::vector<Item> m_scratch;
+};
+
+} // namespace core
+} // namespace engine
@@ -1,12 +1,23 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string>
 #include <string_view>
+#include <vector>
 
+#include <entt/entt.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <spdlog/spdlog.h>
 
 #include "Engine/third_party.hpp"
+#include "Engine/graphics/FrameUniforms.hpp"
+#include "Engine/graphics/ProgramCache.hpp"
+#include "Engine/graphics/StateTracker.hpp"
 
 namespace engine {
 namespace core {
@@ -53,38 +64,179 @@ public:
 
     Shader(const std::string_view vCode, const std::string_view fCode) : ID{::glCreateProgram()}
     {
-        shader_<GL_VERTEX_SHADER> vertex{vCode.data()};
-        shader_<GL_FRAGMENT_SHADER> fragment{fCode.data()};
+        auto &cache = ProgramCache::get();
+        const auto key = cache.key({vCode, fCode});
 
-        CALL_OPEN_GL(::glAttachShader(ID, vertex.ID));
-        CALL_OPEN_GL(::glAttachShader(ID, fragment.ID));
-        CALL_OPEN_GL(::glLinkProgram(ID));
+        if (!cache.load(ID, key)) {
+            const auto start = std::chrono::steady_clock::now();
 
-        check(ID);
+            shader_<GL_VERTEX_SHADER> vertex{vCode.data()};
+            shader_<GL_FRAGMENT_SHADER> fragment{fCode.data()};
+
+            CALL_OPEN_GL(::glAttachShader(ID, vertex.ID));
+            CALL_OPEN_GL(::glAttachShader(ID, fragment.ID));
+            CALL_OPEN_GL(::glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+            CALL_OPEN_GL(::glLinkProgram(ID));
+
+            const auto linked = check(ID);
+
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            cache.addCompileTime(elapsed);
+            spdlog::info(
+                "Engine::Core [Shader] compiled in {:.3f} ms",
+                std::chrono::duration<double, std::milli>{elapsed}.count());
+
+            if (linked) { cache.store(ID, key); }
+
+            CALL_OPEN_GL(::glDetachShader(ID, vertex.ID));
+            CALL_OPEN_GL(::glDetachShader(ID, fragment.ID));
+        }
+
+        const auto frame_block = ::glGetUniformBlockIndex(ID, FrameUniforms::BLOCK_NAME);
+        if (frame_block != GL_INVALID_INDEX)
+            CALL_OPEN_GL(::glUniformBlockBinding(ID, frame_block, FrameUniforms::BINDING));
+
+        reflect();
     }
 
-    static auto check(std::uint32_t id) -> void
+    static auto check(std::uint32_t id) -> bool
     {
         int success;
         std::array<char, 512> log;
         std::fill(log.begin(), log.end(), '\0');
-        CALL_OPEN_GL(::glGetShaderiv(id, GL_LINK_STATUS, &success));
+        CALL_OPEN_GL(::glGetProgramiv(id, GL_LINK_STATUS, &success));
         if (!success) {
-            CALL_OPEN_GL(::glGetShaderInfoLog(id, log.size(), nullptr, log.data()));
+            CALL_OPEN_GL(::glGetProgramInfoLog(id, log.size(), nullptr, log.data()));
             spdlog::error("Engine::Core [Shader] link failed: {}", log.data());
         }
+        return success != 0;
     }
 
     ~Shader() { CALL_OPEN_GL(::glDeleteProgram(ID)); }
 
-    auto use() const noexcept -> void { CALL_OPEN_GL(::glUseProgram(ID)); }
+    auto use(StateTracker &state) const -> void { state.useProgram(ID); }
+
+    [[nodiscard]] auto getID() const noexcept { return ID; }
+
+    // typed index in the uniform table, resolved once with getUniform
+    template<typename T>
+    struct Uniform {
+        static constexpr auto INVALID = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t index{INVALID};
+
+        [[nodiscard]] constexpr auto isValid() const noexcept { return index != INVALID; }
+    };
+
+    // the name is hashed by the caller, use a constexpr entt::hashed_string to have it at compile time
+    template<typename T>
+    [[nodiscard]] auto getUniform(entt::id_type name) const -> Uniform<T>
+    {
+        const auto it = find(m_uniforms, name);
+        if (it == m_uniforms.end()) { return {}; }
+        if (it->type != gl_type<T>()) {
+            spdlog::error("Engine::Core [Shader] uniform {} does not match the requested type", it->name);
+            return {};
+        }
+        return {static_cast<std::uint32_t>(std::distance(m_uniforms.begin(), it))};
+    }
+
+    // the value is only sent to the driver when it differs from the shadow copy
+    template<typename T>
+    auto setUniform(const Uniform<T> handle, const T &value) -> void
+    {
+        if (!handle.isValid()) { return; }
+
+        auto &uniform = m_uniforms[handle.index];
+        auto *shadow = m_shadow.data() + uniform.shadow_offset;
+        if (uniform.cached && std::memcmp(shadow, &value, sizeof(T)) == 0) { return; }
+
+        std::memcpy(shadow, &value, sizeof(T));
+        uniform.cached = true;
+        upload(uniform.location, value);
+    }
 
     template<typename T>
-    auto setUniform(const std::string_view, T) -> void;
+    auto setUniform(entt::id_type name, const T &value) -> void
+    {
+        setUniform(getUniform<T>(name), value);
+    }
+
+    // location of an active vertex attribute, -1 if it does not exist
+    [[nodiscard]] auto getAttribute(entt::id_type name) const noexcept -> GLint
+    {
+        const auto it = find(m_attributes, name);
+        return it == m_attributes.end() ? -1 : it->location;
+    }
 
 private:
     std::uint32_t ID;
+
+    struct Reflected {
+        entt::id_type id;
+        std::string name;
+        GLint location;
+        GLenum type;
+        std::uint32_t shadow_offset;
+        bool cached;
+    };
+
+    // sorted by id
+    std::vector<Reflected> m_uniforms;
+    std::vector<Reflected> m_attributes;
+
+    // last value sent for each uniform, indexed by Reflected::shadow_offset
+    std::vector<std::byte> m_shadow;
+
+    auto reflect() -> void;
+
+    static auto find(const std::vector<Reflected> &table, entt::id_type id) noexcept
+        -> std::vector<Reflected>::const_iterator
+    {
+        const auto it = std::lower_bound(
+            table.begin(), table.end(), id, [](const auto &i, const auto value) { return i.id < value; });
+        return it != table.end() && it->id == id ? it : table.end();
+    }
+
+    template<typename T>
+    static constexpr auto gl_type() noexcept -> GLenum;
+
+    template<typename T>
+    auto upload(GLint location, const T &value) -> void;
 };
 
+template<>
+constexpr auto Shader::gl_type<bool>() noexcept -> GLenum
+{
+    return GL_BOOL;
+}
+
+template<>
+constexpr auto Shader::gl_type<float>() noexcept -> GLenum
+{
+    return GL_FLOAT;
+}
+
+template<>
+constexpr auto Shader::gl_type<glm::vec4>() noexcept -> GLenum
+{
+    return GL_FLOAT_VEC4;
+}
+
+template<>
+constexpr auto Shader::gl_type<glm::mat4>() noexcept -> GLenum
+{
+    return GL_FLOAT_MAT4;
+}
+
+template<>
+auto Shader::upload(GLint location, const bool &) -> void;
+template<>
+auto Shader::upload(GLint location, const float &) -> void;
+template<>
+auto Shader::upload(GLint location, const glm::vec4 &) -> void;
+template<>
+auto Shader::upload(GLint location, const glm::mat4 &) -> void;
+
 } // namespace core
 } // namespace engine
@@ -0,0 +1,223 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Engine/third_party.hpp"
+
+namespace engine {
+namespace core {
+
+// Cache of the GL state set by the engine, the calls which would not change it are skipped
+//
+// The renderers go through the tracker for the program, the vertex array, the buffer binds, the blend and
+// depth state, the clears and the draws, so the calls issued and elided are counted per frame.
+// note : the element array buffer belongs to the vertex array, its binds are issued but never cached
+class StateTracker {
+public:
+    struct Stats {
+        std::size_t programs;      // glUseProgram
+        std::size_t vertex_arrays; // glBindVertexArray
+        std::size_t buffers;       // glBindBuffer
+        std::size_t states;        // glEnable / glDisable, blend and depth functions, clear color
+        std::size_t clears;
+        std::size_t draws;
+        std::size_t issued;        // every call above
+        std::size_t elided;        // calls skipped, the state being already set
+    };
+
+    // keep the stats of the frame which ends and forget the cached state, which the modules may have touched
+    auto newFrame() noexcept -> void
+    {
+        m_frame = m_stats;
+        m_stats = {};
+        invalidate();
+    }
+
+    // forget the cached state, to be called when something else may have touched it
+    auto invalidate() noexcept -> void
+    {
+        m_program = INVALID;
+        m_vao = INVALID;
+        m_buffers.fill(INVALID);
+        m_capabilities.fill(Capability::UNKNOWN);
+        m_blend = {INVALID, INVALID};
+        m_depth_function = INVALID;
+        m_depth_mask = Capability::UNKNOWN;
+        m_clear_color.reset();
+    }
+
+    // note : the stats of the last complete frame
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_frame; }
+
+    auto useProgram(GLuint program) -> void
+    {
+        if (elide(m_program == program)) { return; }
+        CALL_OPEN_GL(::glUseProgram(program));
+        m_program = program;
+        issue(m_stats.programs);
+    }
+
+    auto bindVertexArray(GLuint vao) -> void
+    {
+        if (elide(m_vao == vao)) { return; }
+        CALL_OPEN_GL(::glBindVertexArray(vao));
+        m_vao = vao;
+        issue(m_stats.vertex_arrays);
+    }
+
+    auto bindBuffer(GLenum target, GLuint buffer) -> void
+    {
+        const auto index = bufferIndex(target);
+        if (index != BUFFER_TARGETS.size() && elide(m_buffers[index] == buffer)) { return; }
+        CALL_OPEN_GL(::glBindBuffer(target, buffer));
+        if (index != BUFFER_TARGETS.size()) { m_buffers[index] = buffer; }
+        issue(m_stats.buffers);
+    }
+
+    // note : the capabilities out of CAPABILITIES are always issued
+    auto enable(GLenum capability, bool value) -> void
+    {
+        const auto index = capabilityIndex(capability);
+        const auto state = value ? Capability::ENABLED : Capability::DISABLED;
+        if (index != CAPABILITIES.size() && elide(m_capabilities[index] == state)) { return; }
+        if (value) {
+            CALL_OPEN_GL(::glEnable(capability));
+        } else {
+            CALL_OPEN_GL(::glDisable(capability));
+        }
+        if (index != CAPABILITIES.size()) { m_capabilities[index] = state; }
+        issue(m_stats.states);
+    }
+
+    auto blendFunc(GLenum source, GLenum destination) -> void
+    {
+        if (elide(m_blend[0] == source && m_blend[1] == destination)) { return; }
+        CALL_OPEN_GL(::glBlendFunc(source, destination));
+        m_blend = {source, destination};
+        issue(m_stats.states);
+    }
+
+    auto depthFunc(GLenum function) -> void
+    {
+        if (elide(m_depth_function == function)) { return; }
+        CALL_OPEN_GL(::glDepthFunc(function));
+        m_depth_function = function;
+        issue(m_stats.states);
+    }
+
+    auto depthMask(bool value) -> void
+    {
+        const auto state = value ? Capability::ENABLED : Capability::DISABLED;
+        if (elide(m_depth_mask == state)) { return; }
+        CALL_OPEN_GL(::glDepthMask(value ? GL_TRUE : GL_FALSE));
+        m_depth_mask = state;
+        issue(m_stats.states);
+    }
+
+    auto clearColor(const glm::vec4 &color) -> void
+    {
+        if (elide(m_clear_color.valid && m_clear_color.value == color)) { return; }
+        CALL_OPEN_GL(::glClearColor(color.r, color.g, color.b, color.a));
+        m_clear_color = {color, true};
+        issue(m_stats.states);
+    }
+
+    auto clear(GLbitfield mask) -> void
+    {
+        CALL_OPEN_GL(::glClear(mask));
+        issue(m_stats.clears);
+    }
+
+    auto drawArrays(GLenum mode, GLint first, GLsizei count, GLsizei instances = 1) -> void
+    {
+        if (instances == 1) {
+            CALL_OPEN_GL(::glDrawArrays(mode, first, count));
+        } else {
+            CALL_OPEN_GL(::glDrawArraysInstanced(mode, first, count, instances));
+        }
+        issue(m_stats.draws);
+    }
+
+    // note : first is in indices, the indices are uint32
+    auto drawElements(GLenum mode, GLsizei count, std::size_t first = 0, GLsizei instances = 1) -> void
+    {
+        const auto offset = reinterpret_cast<const void *>(first * sizeof(GLuint));
+        if (instances == 1) {
+            CALL_OPEN_GL(::glDrawElements(mode, count, GL_UNSIGNED_INT, offset));
+        } else {
+            CALL_OPEN_GL(::glDrawElementsInstanced(mode, count, GL_UNSIGNED_INT, offset, instances));
+        }
+        issue(m_stats.draws);
+    }
+
+    // note : offset is in bytes in the bound draw indirect buffer
+    auto multiDrawElementsIndirect(GLenum mode, std::size_t offset, GLsizei count, GLsizei stride) -> void
+    {
+        CALL_OPEN_GL(::glMultiDrawElementsIndirect(
+            mode, GL_UNSIGNED_INT, reinterpret_cast<const void *>(offset), count, stride));
+        issue(m_stats.draws);
+    }
+
+private:
+    // note : 0 is a valid name (unbind), use a name never returned by the driver
+    static constexpr GLuint INVALID{~0u};
+
+    // the targets not bound to a vertex array, the others are never elided
+    static constexpr auto BUFFER_TARGETS = std::to_array<GLenum>({GL_ARRAY_BUFFER, GL_DRAW_INDIRECT_BUFFER});
+
+    static constexpr auto CAPABILITIES = std::to_array<GLenum>({GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE});
+
+    enum class Capability : std::uint8_t { UNKNOWN, ENABLED, DISABLED };
+
+    struct ClearColor {
+        glm::vec4 value;
+        bool valid;
+
+        auto reset() noexcept -> void { valid = false; }
+    };
+
+    static constexpr auto bufferIndex(GLenum target) noexcept -> std::size_t
+    {
+        std::size_t i = 0;
+        while (i != BUFFER_TARGETS.size() && BUFFER_TARGETS[i] != target) { i++; }
+        return i;
+    }
+
+    static constexpr auto capabilityIndex(GLenum capability) noexcept -> std::size_t
+    {
+        std::size_t i = 0;
+        while (i != CAPABILITIES.size() && CAPABILITIES[i] != capability) { i++; }
+        return i;
+    }
+
+    auto elide(bool same) noexcept -> bool
+    {
+        if (same) { m_stats.elided++; }
+        return same;
+    }
+
+    auto issue(std::size_t &counter) noexcept -> void
+    {
+        counter++;
+        m_stats.issued++;
+    }
+
+    GLuint m_program{INVALID};
+    GLuint m_vao{INVALID};
+    std::array<GLuint, BUFFER_TARGETS.size()> m_buffers{INVALID, INVALID};
+    std::array<Capability, CAPABILITIES.size()> m_capabilities{};
+    std::array<GLenum, 2> m_blend{INVALID, INVALID};
+    GLenum m_depth_function{INVALID};
+    Capability m_depth_mask{Capability::UNKNOWN};
+    ClearColor m_clear_color{glm::vec4{0.0f}, false};
+
+    Stats m_stats{};
+    Stats m_frame{};
+};
+
+} // namespace core
+} // namespace engine
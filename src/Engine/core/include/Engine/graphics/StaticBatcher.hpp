@@ -0,0 +1,174 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/graphics/Shader.hpp"
+
+namespace engine {
+namespace core {
+
+// Merge the meshes of the api::Static entities in one vertex / index buffer per display mode
+//
+// The vertices are transformed by the world matrix and multiplied by the tint when the entity joins a batch
+// or when one of its components changes, a batch is then drawn in one call without any per-entity data.
+// Only the list modes can be merged : the strips, loops and fans and the translucent entities are left to the
+// renderers. The vertices are decoded from any api::VertexLayout, the batches store full precision floats.
+class StaticBatcher {
+public:
+    // range of the entity in its batch, the renderers skip the entities owning one
+    struct Member {
+        std::uint32_t batch;
+        std::uint32_t first_vertex;
+        std::uint32_t vertex_count;
+        std::uint32_t first_index;
+        std::uint32_t index_count;
+        std::uint64_t content_hash;
+    };
+
+    struct Stats {
+        std::size_t batches;
+        std::size_t members;
+        std::size_t vertices;
+        std::size_t indices;
+        std::size_t written;  // entities whose vertices were transformed this frame
+        std::size_t repacked; // batches compacted after a removal this frame
+        std::size_t draw_calls;
+    };
+
+    explicit StaticBatcher(entt::registry &world);
+    ~StaticBatcher();
+
+    StaticBatcher(const StaticBatcher &) = delete;
+    StaticBatcher &operator=(const StaticBatcher &) = delete;
+
+    // apply the changes of the static entities since the last call, only the modified ranges are uploaded
+    auto update() -> void;
+
+    // draw the batches intersecting the view, they are opaque so they go before the other entities
+    auto draw(const glm::mat4 &view_projection, StateTracker &state) -> void;
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec4 color;
+    };
+
+    // mesh read back from the gpu, shared by the entities with the same content hash
+    struct Source {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec4> colors;
+        std::vector<std::uint32_t> indices;
+    };
+
+    // elements modified since the last upload
+    struct Range {
+        std::size_t first{std::numeric_limits<std::size_t>::max()};
+        std::size_t last{0};
+
+        auto add(std::size_t from, std::size_t to) noexcept -> void
+        {
+            first = std::min(first, from);
+            last = std::max(last, to);
+        }
+
+        [[nodiscard]] auto empty() const noexcept { return first >= last; }
+    };
+
+    struct Entry {
+        entt::entity entity;
+        std::uint32_t first_vertex; // tells the current range of the entity from a previous one
+    };
+
+    struct Batch {
+        api::VAO::DisplayMode mode;
+
+        GLuint vao{0};
+        GLuint vertex_buffer{0};
+        GLuint index_buffer{0};
+        std::size_t vertex_capacity{0};
+        std::size_t index_capacity{0};
+
+        // cpu mirror of the buffers, the indices already include the first vertex of each member
+        std::vector<Vertex> vertices;
+        std::vector<std::uint32_t> indices;
+
+        // in the order of the ranges, the removed entities stay until the batch is repacked
+        std::vector<Entry> entries;
+        std::size_t removed{0};
+
+        Range dirty_vertices;
+        Range dirty_indices;
+
+        // note : the bounds only grow when a member is rewritten, they are recomputed when repacked
+        glm::vec3 min{std::numeric_limits<float>::max()};
+        glm::vec3 max{-std::numeric_limits<float>::max()};
+    };
+
+    auto on_change(entt::registry &, entt::entity entity) -> void { m_dirty.push_back(entity); }
+
+    auto on_destroy_member(entt::registry &world, entt::entity entity) -> void;
+
+    template<typename... Component>
+    auto connect() -> void
+    {
+        ((m_world.on_construct<Component>().template connect<&StaticBatcher::on_change>(*this),
+          m_world.on_update<Component>().template connect<&StaticBatcher::on_change>(*this),
+          m_world.on_destroy<Component>().template connect<&StaticBatcher::on_change>(*this)),
+         ...);
+    }
+
+    template<typename... Component>
+    auto disconnect() -> void
+    {
+        ((m_world.on_construct<Component>().template disconnect<&StaticBatcher::on_change>(*this),
+          m_world.on_update<Component>().template disconnect<&StaticBatcher::on_change>(*this),
+          m_world.on_destroy<Component>().template disconnect<&StaticBatcher::on_change>(*this)),
+         ...);
+    }
+
+    // return the mesh of the entity, nullptr if it cannot be batched
+    auto import(entt::entity entity) -> const Source *;
+
+    auto getBatch(api::VAO::DisplayMode mode) -> std::uint32_t;
+
+    // transform the vertices of the source in the range of the member
+    auto write(
+        Batch &batch,
+        const Member &member,
+        const Source &source,
+        const glm::mat4 &model,
+        const glm::vec4 &tint) -> void;
+
+    // drop the ranges of the removed members, the following ones are moved down
+    auto repack(std::uint32_t index) -> void;
+
+    auto upload(Batch &batch) -> void;
+
+    entt::registry &m_world;
+
+    Shader m_shader;
+
+    std::vector<Batch> m_batches;
+
+    // note : the sources are never released, like the meshes of the GeometryArena
+    std::unordered_map<std::uint64_t, std::optional<Source>> m_sources;
+
+    std::vector<entt::entity> m_dirty;
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
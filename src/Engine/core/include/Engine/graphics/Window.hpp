@@ -1,9 +1,17 @@
 #pragma once
 
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+
 #include <glm/vec2.hpp>
 
 #include "Engine/third_party.hpp"
 #include "Engine/Event.hpp"
+#include "Engine/graphics/FrameReadback.hpp"
+#include "Engine/graphics/ImageEncoder.hpp"
 
 namespace engine {
 namespace core {
@@ -12,7 +20,9 @@ class Core;
 
 class Window {
 public:
-    Window(int width, int height, const std::string_view name);
+    // note : a headless window belongs to the null platform of GLFW, no display is needed,
+    //        it renders into an offscreen framebuffer of the same size
+    Window(int width, int height, const std::string_view name, bool headless = false);
 
     ~Window();
 
@@ -20,12 +30,29 @@ public:
 
     auto create_ui_context() -> bool;
 
+    // must be called once the OpenGL functions are loaded, the framebuffer stays bound until destruction
+    auto create_offscreen_target() -> bool;
+
+    [[nodiscard]] auto isHeadless() const noexcept -> bool { return m_headless; }
+
+    // close the window after the given number of rendered frames, 0 means never
+    auto setFrameLimit(std::size_t frames) noexcept -> void { m_frame_limit = frames; }
+
+    [[nodiscard]] auto getFrameCount() const noexcept -> std::size_t { return m_frame_count; }
+
     [[nodiscard]] auto isOpen() const noexcept -> bool;
 
+    // note : a headless window is never iconified
+    [[nodiscard]] auto isIconified() const noexcept -> bool;
+
     auto render() -> void;
 
+    // the frame is read back when rendered and written to disk in the background a few frames later
     auto screenshot(const std::string_view filename) -> bool;
 
+    // capture every following frame in the directory, numbered in order and listed in its index.csv
+    auto record(const std::filesystem::path &directory, ImageEncoder::Format format) -> bool;
+
     template<typename T = double>
     [[nodiscard]] auto getAspectRatio() const noexcept -> T
     {
@@ -51,8 +78,30 @@ public:
     }
 
 private:
+    auto capture() -> void;
+
+    struct Recording {
+        std::filesystem::path directory;
+        ImageEncoder::Format format;
+        std::size_t sequence;
+        std::ofstream index;
+    };
+
     ::GLFWwindow *m_handle{nullptr};
     ::ImGuiContext *m_ui_context{nullptr};
+
+    bool m_headless{false};
+    GLuint m_framebuffer{0};
+    GLuint m_color{0};
+    GLuint m_depth{0};
+
+    ImageEncoder m_encoder;
+    std::optional<FrameReadback> m_readback;
+    std::optional<std::string> m_screenshot;
+    std::optional<Recording> m_recording;
+
+    std::size_t m_frame_limit{0};
+    std::size_t m_frame_count{0};
 };
 
 template<>
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <tuple>
+#include <utility>
+
+#include <entt/entt.hpp>
+
+namespace engine {
+namespace core {
+
+// Read access to the components an entity may lack, while iterating the ones it always has
+//
+// The pool of each component is resolved once at construction, a read is then a lookup in its sparse set
+// instead of the search of the pool by type done by registry::try_get. Adding a component to the list does
+// not add a pass over the entities, unlike a view per combination of the components present.
+template<typename... Component>
+class Optional {
+public:
+    explicit Optional(entt::registry &world) : m_views{world.view<const Component>()...} {}
+
+    // nullptr when the entity does not have the component
+    template<typename T>
+    [[nodiscard]] auto find(entt::entity entity) const -> const T *
+    {
+        const auto &view = std::get<View<T>>(m_views);
+        return view.contains(entity) ? &view.get(entity) : nullptr;
+    }
+
+    template<typename T>
+    [[nodiscard]] auto has(entt::entity entity) const -> bool
+    {
+        return std::get<View<T>>(m_views).contains(entity);
+    }
+
+    // note : the default is returned by reference, it must outlive the result
+    template<typename T>
+    [[nodiscard]] auto get(entt::entity entity, const T &fallback) const -> const T &
+    {
+        const auto component = find<T>(entity);
+        return component ? *component : fallback;
+    }
+
+    template<typename T>
+    auto get(entt::entity entity, const T &&fallback) const -> const T & = delete;
+
+private:
+    template<typename T>
+    using View = decltype(std::declval<entt::registry &>().view<const T>());
+
+    std::tuple<View<Component>...> m_views;
+};
+
+} // namespace core
+} // namespace engine
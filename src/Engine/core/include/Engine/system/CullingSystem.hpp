@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/system/DynamicBVH.hpp"
+
+namespace engine {
+namespace core {
+
+// Keep the world space bounds of the entities in a DynamicBVH and cull the ones outside of the view
+//
+// The entities without api::AABB are never culled.
+class CullingSystem {
+public:
+    // leaf of the entity in the tree
+    struct Proxy {
+        std::uint32_t leaf;
+        std::uint32_t visible_frame;
+    };
+
+    struct Stats {
+        std::size_t visible;
+        std::size_t culled;
+        std::size_t reinserted;
+        int height;
+    };
+
+    explicit CullingSystem(entt::registry &world);
+    ~CullingSystem();
+
+    CullingSystem(const CullingSystem &) = delete;
+    CullingSystem &operator=(const CullingSystem &) = delete;
+
+    // refit the tree with the bounds changed since the last call, then query the visible entities
+    auto update(const glm::mat4 &view_projection) -> void;
+
+    [[nodiscard]] auto isVisible(entt::entity entity) const -> bool
+    {
+        if (!m_enabled) { return true; }
+        const auto proxy = m_world.try_get<Proxy>(entity);
+        return !proxy || proxy->visible_frame == m_frame;
+    }
+
+    [[nodiscard]] auto isEnabled() const noexcept { return m_enabled; }
+
+    auto setEnabled(bool value) noexcept -> void { m_enabled = value; }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+    // bounds of the local box once transformed by the world matrix
+    [[nodiscard]] static auto transform(const api::AABB &local, const glm::mat4 &world) noexcept
+        -> DynamicBVH::Box;
+
+private:
+    auto on_change(entt::registry &, entt::entity entity) -> void { m_dirty.push_back(entity); }
+
+    auto on_destroy_proxy(entt::registry &world, entt::entity entity) -> void;
+
+    template<typename... Component>
+    auto connect() -> void
+    {
+        ((m_world.on_construct<Component>().template connect<&CullingSystem::on_change>(*this),
+          m_world.on_update<Component>().template connect<&CullingSystem::on_change>(*this),
+          m_world.on_destroy<Component>().template connect<&CullingSystem::on_change>(*this)),
+         ...);
+    }
+
+    template<typename... Component>
+    auto disconnect() -> void
+    {
+        ((m_world.on_construct<Component>().template disconnect<&CullingSystem::on_change>(*this),
+          m_world.on_update<Component>().template disconnect<&CullingSystem::on_change>(*this),
+          m_world.on_destroy<Component>().template disconnect<&CullingSystem::on_change>(*this)),
+         ...);
+    }
+
+    entt::registry &m_world;
+
+    DynamicBVH m_tree;
+
+    std::vector<entt::entity> m_dirty;
+
+    bool m_enabled{true};
+    std::uint32_t m_frame{0};
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
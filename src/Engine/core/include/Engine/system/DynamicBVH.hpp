@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include "Engine/graphics/Frustum.hpp"
+
+namespace engine {
+namespace core {
+
+// Bounding volume hierarchy of world space boxes, updated incrementally
+//
+// The leaves store a fattened box so the small moves do not modify the tree,
+// the tree is kept balanced with rotations when a leaf is inserted or removed.
+class DynamicBVH {
+public:
+    static constexpr auto NIL = std::numeric_limits<std::uint32_t>::max();
+
+    // margin added around the boxes of the leaves
+    static constexpr auto MARGIN = 0.1f;
+
+    struct Box {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    // return the leaf, to be given to move and remove
+    auto insert(const Box &box, entt::entity entity) -> std::uint32_t;
+
+    auto remove(std::uint32_t leaf) -> void;
+
+    // return true if the leaf had to be reinserted
+    auto move(std::uint32_t leaf, const Box &box) -> bool;
+
+    // call visit with the entity of each leaf not outside the frustum
+    template<typename Visitor>
+    auto query(const Frustum &frustum, Visitor &&visit) const -> void
+    {
+        if (m_root == NIL) { return; }
+
+        m_stack.clear();
+        m_stack.push_back({m_root, false});
+        while (!m_stack.empty()) {
+            const auto [index, inside] = m_stack.back();
+            m_stack.pop_back();
+
+            const auto &node = m_nodes[index];
+            auto node_inside = inside;
+            if (!inside) {
+                const auto result = frustum.classify(node.box.min, node.box.max);
+                if (result == Frustum::Result::OUTSIDE) { continue; }
+                node_inside = result == Frustum::Result::INSIDE;
+            }
+
+            if (node.isLeaf()) {
+                visit(node.entity);
+            } else {
+                m_stack.push_back({node.left, node_inside});
+                m_stack.push_back({node.right, node_inside});
+            }
+        }
+    }
+
+    [[nodiscard]] auto size() const noexcept { return m_leaves; }
+
+    [[nodiscard]] auto getHeight() const noexcept { return m_root == NIL ? 0 : m_nodes[m_root].height; }
+
+private:
+    struct Node {
+        Box box;
+        std::uint32_t parent; // next free node when not used
+        std::uint32_t left;
+        std::uint32_t right;
+        std::int32_t height; // 0 for a leaf, -1 when not used
+        entt::entity entity;
+
+        [[nodiscard]] auto isLeaf() const noexcept { return left == NIL; }
+    };
+
+    struct Visit {
+        std::uint32_t index;
+        bool inside; // the parent is fully inside the frustum, the children are not tested
+    };
+
+    auto allocate() -> std::uint32_t;
+    auto release(std::uint32_t index) -> void;
+
+    auto insertLeaf(std::uint32_t leaf) -> void;
+    auto removeLeaf(std::uint32_t leaf) -> void;
+
+    // refit the boxes and heights from index up to the root
+    auto refit(std::uint32_t index) -> void;
+    auto balance(std::uint32_t index) -> std::uint32_t;
+
+    std::vector<Node> m_nodes;
+    std::uint32_t m_root{NIL};
+    std::uint32_t m_free{NIL};
+    std::size_t m_leaves{0};
+
+    mutable std::vector<Visit> m_stack;
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <entt/entt.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/graphics/FrameUniforms.hpp"
+#include "Engine/system/CullingSystem.hpp"
+
+namespace engine {
+namespace core {
+
+// Select the api::LOD level of the visible entities from the size of their bounds on the screen
+class LODSystem {
+public:
+    // radius of the bounds on the screen, relative to its half height, under which a level is used
+    static constexpr std::array<float, api::LOD::MAX_LEVELS> THRESHOLDS{1.0f, 0.25f, 0.12f, 0.06f};
+
+    // margin around the thresholds so a level does not switch back and forth at the limit
+    static constexpr float HYSTERESIS{0.15f};
+
+    struct Stats {
+        std::array<std::size_t, api::LOD::MAX_LEVELS> entities; // number of visible entities per level
+        std::size_t triangles;                                  // drawn by the visible entities with a LOD
+        std::size_t full_triangles;                             // the same entities at full detail
+    };
+
+    explicit LODSystem(entt::registry &world) : m_world{world} {}
+
+    auto update(const FrameUniforms::Block &frame, const CullingSystem &culling) -> void;
+
+    [[nodiscard]] auto isEnabled() const noexcept { return m_enabled; }
+
+    auto setEnabled(bool value) noexcept -> void { m_enabled = value; }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+    // range of indices to draw in the element buffer, the whole mesh for the entities without LOD
+    [[nodiscard]] static auto select(const api::VAO &vao, const api::LOD *lod) noexcept -> api::LOD::Level
+    {
+        if (lod == nullptr || vao.mode != api::VAO::DisplayMode::TRIANGLES) { return {vao.first, vao.count}; }
+        const auto &level = lod->levels[lod->current];
+        return {vao.first + level.first, level.count};
+    }
+
+private:
+    entt::registry &m_world;
+
+    bool m_enabled{true};
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/graphics/OcclusionBuffer.hpp"
+#include "Engine/system/CullingSystem.hpp"
+
+namespace engine {
+namespace core {
+
+// Cull the entities hidden behind the api::Occluder entities, tested against an OcclusionBuffer
+//
+// The occluders in the view are rasterized each frame, one band of the buffer per job on a pool of threads.
+// The entities without api::AABB and the occluders themselves are never hidden.
+class OcclusionSystem {
+public:
+    struct Stats {
+        std::size_t occluders;
+        std::size_t triangles;
+        std::size_t tested;
+        std::size_t occluded;
+        std::chrono::nanoseconds raster_time;
+    };
+
+    // note : 0 worker picks half of the hardware threads, the calling thread rasterizes bands too
+    explicit OcclusionSystem(entt::registry &world, std::size_t workers = 0);
+    ~OcclusionSystem();
+
+    OcclusionSystem(const OcclusionSystem &) = delete;
+    OcclusionSystem &operator=(const OcclusionSystem &) = delete;
+
+    // rasterize the occluders visible by the culling and build the pyramid
+    auto update(const glm::mat4 &view_projection, const CullingSystem &culling) -> void;
+
+    // false when the bounds of the entity are behind the occluders, counted in the stats
+    [[nodiscard]] auto test(entt::entity entity) -> bool;
+
+    [[nodiscard]] auto isEnabled() const noexcept { return m_enabled; }
+
+    auto setEnabled(bool value) noexcept -> void { m_enabled = value; }
+
+    [[nodiscard]] auto getBuffer() const noexcept -> const OcclusionBuffer & { return m_buffer; }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+private:
+    // triangles of an occluder read back from the gpu, shared by the entities with the same content hash
+    struct Mesh {
+        std::vector<glm::vec3> positions;
+        std::vector<std::uint32_t> indices;
+    };
+
+    // return the mesh of the entity, nullptr if it cannot be rasterized
+    auto import(entt::entity entity, const api::VAO &vao) -> const Mesh *;
+
+    auto run() -> void;
+
+    // rasterize the bands until none is left
+    auto work() -> void;
+
+    entt::registry &m_world;
+
+    OcclusionBuffer m_buffer;
+
+    // note : the meshes are never released, like the meshes of the GeometryArena
+    std::unordered_map<std::uint64_t, std::optional<Mesh>> m_meshes;
+
+    bool m_enabled{true};
+
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    std::uint64_t m_generation{0};
+    bool m_stop{false};
+    std::atomic<std::size_t> m_next_band{OcclusionBuffer::BANDS};
+    std::atomic<std::size_t> m_remaining{0};
+
+    std::vector<std::thread> m_workers;
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
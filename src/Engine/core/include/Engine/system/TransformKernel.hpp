@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace engine {
+namespace core {
+namespace simd {
+
+enum class ISA {
+    SCALAR,
+    SSE4, // SSE 4.1
+    AVX2, // AVX2 + FMA
+};
+
+// Structure of arrays of the transform of `count` entities, the rotation is in degree
+struct TransformInputs {
+    const float *position[3];
+    const float *rotation[3];
+    const float *scale[3];
+};
+
+// best instruction set supported by the cpu running the engine
+[[nodiscard]] auto detect_isa() noexcept -> ISA;
+
+[[nodiscard]] auto is_supported(ISA isa) noexcept -> bool;
+
+// write `count` column-major matrices (translate * rotateX * rotateY * rotateZ * scale) in `out`
+auto compute_transforms(
+    const TransformInputs &in, float *out, std::size_t count, ISA isa = detect_isa()) noexcept -> void;
+
+namespace detail {
+
+// compute the entities [first, count[ and return the number of entities processed
+
+auto compute_transforms_scalar(
+    const TransformInputs &in, float *out, std::size_t first, std::size_t count) noexcept -> std::size_t;
+
+auto compute_transforms_sse4(const TransformInputs &in, float *out, std::size_t count) noexcept
+    -> std::size_t;
+
+auto compute_transforms_avx2(const TransformInputs &in, float *out, std::size_t count) noexcept
+    -> std::size_t;
+
+} // namespace detail
+
+} // namespace simd
+} // namespace core
+} // namespace engine
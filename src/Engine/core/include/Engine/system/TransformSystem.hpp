@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/component/all.hpp>
+
+#include "Engine/system/TransformKernel.hpp"
+
+namespace engine {
+namespace core {
+
+// Maintain the api::Transform of the entities, only recomputed when Position / Rotation / Scale change
+class TransformSystem {
+public:
+    // binding point of the shader storage buffer holding the world matrices
+    static constexpr GLuint BINDING{0};
+
+    struct Stats {
+        std::size_t computed;
+        std::size_t uploaded;
+    };
+
+    explicit TransformSystem(entt::registry &world);
+    ~TransformSystem();
+
+    TransformSystem(const TransformSystem &) = delete;
+    TransformSystem &operator=(const TransformSystem &) = delete;
+
+    // reference implementation, the system use the batched kernel of simd::compute_transforms
+    [[nodiscard]] static auto
+        compute(const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale) -> glm::mat4;
+
+    // recompute the entities modified since the last call and upload them to the gpu copy
+    auto update() -> void;
+
+    [[nodiscard]] auto getBuffer() const noexcept { return m_buffer; }
+
+    [[nodiscard]] auto getStats() const noexcept -> const Stats & { return m_stats; }
+
+    [[nodiscard]] auto getISA() const noexcept { return m_isa; }
+
+    auto setISA(simd::ISA isa) noexcept -> void
+    {
+        m_isa = simd::is_supported(isa) ? isa : simd::detect_isa();
+    }
+
+private:
+    auto on_change(entt::registry &, entt::entity entity) -> void { m_dirty.push_back(entity); }
+
+    auto on_destroy_transform(entt::registry &world, entt::entity entity) -> void;
+
+    template<typename... Component>
+    auto connect() -> void
+    {
+        ((m_world.on_construct<Component>().template connect<&TransformSystem::on_change>(*this),
+          m_world.on_update<Component>().template connect<&TransformSystem::on_change>(*this),
+          m_world.on_destroy<Component>().template connect<&TransformSystem::on_change>(*this)),
+         ...);
+    }
+
+    template<typename... Component>
+    auto disconnect() -> void
+    {
+        ((m_world.on_construct<Component>().template disconnect<&TransformSystem::on_change>(*this),
+          m_world.on_update<Component>().template disconnect<&TransformSystem::on_change>(*this),
+          m_world.on_destroy<Component>().template disconnect<&TransformSystem::on_change>(*this)),
+         ...);
+    }
+
+    entt::registry &m_world;
+
+    std::vector<entt::entity> m_dirty;
+
+    // scratch memory of the kernel
+    std::vector<entt::entity> m_pending;
+    std::vector<float> m_inputs;
+    std::vector<glm::mat4> m_outputs;
+    simd::ISA m_isa{simd::detect_isa()};
+
+    std::vector<glm::mat4> m_matrices; // cpu mirror of the gpu copy, indexed by api::Transform::slot
+    std::vector<std::uint32_t> m_free_slots;
+
+    GLuint m_buffer{0};
+    std::size_t m_capacity{0};
+
+    Stats m_stats{};
+};
+
+} // namespace core
+} // namespace engine
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <Engine/graphics/Shader.hpp>
 #include <Engine/Camera.hpp>
 
 namespace engine {
@@ -9,7 +8,6 @@ namespace core {
 namespace widget {
 
 struct CameraWidget {
-    engine::core::Shader &shader;
     engine::core::Camera &camera;
 
     auto draw(bool &camera_auto_move) const -> void
@@ -24,7 +22,6 @@ struct CameraWidget {
         }
         if (projection_changed) {
             camera.setProjectionType(magic_enum::enum_cast<Camera::ProjectionType>(new_projection).value());
-            shader.setUniform("projection", camera.getProjection());
         }
         ImGui::InputFloat3("Position", &camera.getPosition().x, 3);
         ImGui::SameLine();
@@ -12,9 +12,10 @@ struct ComponentTree {
 
 private:
     template<typename T>
-    auto drawComponentTweaker(T &) const -> void
+    auto drawComponentTweaker(T &) const -> bool
     {
         ImGui::Text("<not implemented>");
+        return false;
     }
 };
 
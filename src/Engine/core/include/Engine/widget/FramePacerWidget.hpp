@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Engine/graphics/FramePacer.hpp>
+
+namespace engine {
+namespace core {
+
+namespace widget {
+
+struct FramePacerWidget {
+    FramePacer &pacer;
+
+    auto draw() const -> void
+    {
+        ImGui::Text("VSync ");
+        auto vsync = magic_enum::enum_integer(pacer.getVSync());
+        for (const auto &i : magic_enum::enum_values<FramePacer::VSync>()) {
+            ImGui::SameLine();
+            if (ImGui::RadioButton(magic_enum::enum_name(i).data(), &vsync, magic_enum::enum_integer(i))) {
+                pacer.setVSync(i);
+            }
+        }
+
+        auto max_fps = static_cast<float>(pacer.getMaxFps());
+        if (ImGui::SliderFloat("Max fps (0: unlimited)", &max_fps, 0.0f, 240.0f, "%.0f")) {
+            pacer.setMaxFps(static_cast<double>(max_fps));
+        }
+        ImGui::Text("Frames in flight: %zu", pacer.getFramesInFlight());
+
+        ImGui::Separator();
+
+        const auto &stats = pacer.getStats();
+        const auto count = pacer.getCount();
+        const auto times = GpuProfiler::summarize(pacer.getFrameTimes(), count);
+        ImGui::Text("Frame min %.3f avg %.3f p99 %.3f ms", times.min, times.avg, times.p99);
+        ImGui::Text("Jitter: %.3f ms", stats.jitter);
+        ImGui::PlotLines(
+            "Frame", pacer.getFrameTimes().data(), static_cast<int>(count), static_cast<int>(pacer.getOffset()));
+        ImGui::Text("Missed deadlines: %zu", stats.missed);
+        ImGui::Text("GPU stalls: %zu", stats.fence_stalls);
+        ImGui::Text("GPU wait: %.3f ms", std::chrono::duration<double, std::milli>{stats.fence_wait}.count());
+        ImGui::Text("Slept: %.3f ms", std::chrono::duration<double, std::milli>{stats.slept}.count());
+        ImGui::Text("Spun: %.3f ms", std::chrono::duration<double, std::milli>{stats.spun}.count());
+    }
+};
+
+} // namespace widget
+
+} // namespace core
+} // namespace engine
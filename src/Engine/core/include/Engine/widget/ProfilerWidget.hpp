@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Engine/graphics/GpuProfiler.hpp>
+
+namespace engine {
+namespace core {
+
+namespace widget {
+
+struct ProfilerWidget {
+    const GpuProfiler &profiler;
+
+    auto draw() const -> void
+    {
+        ImGui::Text("Latency: %zu frames", GpuProfiler::LATENCY);
+        ImGui::Text("Results dropped: %zu", profiler.getDropped());
+
+        for (const auto &section : profiler.getSections()) {
+            const auto count = section.getCount();
+            const auto offset = static_cast<int>(section.getOffset());
+            const auto cpu = GpuProfiler::summarize(section.cpu, count);
+            const auto gpu = GpuProfiler::summarize(section.gpu, count);
+
+            ImGui::Separator();
+            ImGui::Text("%s", section.name.data());
+            ImGui::Text("CPU min %.3f avg %.3f p99 %.3f ms", cpu.min, cpu.avg, cpu.p99);
+            ImGui::PushID(section.name.data());
+            ImGui::PlotLines("CPU", section.cpu.data(), static_cast<int>(count), offset);
+            ImGui::Text("GPU min %.3f avg %.3f p99 %.3f ms", gpu.min, gpu.avg, gpu.p99);
+            ImGui::PlotLines("GPU", section.gpu.data(), static_cast<int>(count), offset);
+            ImGui::PopID();
+        }
+    }
+};
+
+} // namespace widget
+
+} // namespace core
+} // namespace engine
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <Engine/resource/BufferAllocator.hpp>
+#include <Engine/resource/ObjectPool.hpp>
+#include <Engine/resource/RingBuffer.hpp>
+#include <Engine/Core.hpp>
+#include <Engine/graphics/IndirectRenderer.hpp>
+#include <Engine/graphics/InstancedRenderer.hpp>
+#include <Engine/graphics/StaticBatcher.hpp>
+#include <Engine/graphics/StateTracker.hpp>
+#include <Engine/system/CullingSystem.hpp>
+#include <Engine/system/LODSystem.hpp>
+#include <Engine/system/OcclusionSystem.hpp>
+#include <Engine/system/TransformSystem.hpp>
+
+namespace engine {
+namespace core {
+
+namespace widget {
+
+struct RendererWidget {
+    Core::RenderingMode &rendering_mode;
+    const std::size_t &direct_draw_calls;
+    const StateTracker &state_tracker;
+    const InstancedRenderer &instanced_renderer;
+    const IndirectRenderer &indirect_renderer;
+    TransformSystem &transforms;
+    CullingSystem &culling;
+    OcclusionSystem &occlusion;
+    LODSystem &lods;
+    const StaticBatcher &static_batcher;
+    const api::RingBuffer &ring_buffer;
+    const api::ObjectPool &object_pool;
+    const api::BufferAllocator &buffer_allocator;
+    bool &defragment;
+
+    auto draw() const -> void
+    {
+        ImGui::Text("Rendering Mode ");
+        auto mode = magic_enum::enum_integer(rendering_mode);
+        for (const auto &i : magic_enum::enum_values<Core::RenderingMode>()) {
+            ImGui::SameLine();
+            if (ImGui::RadioButton(magic_enum::enum_name(i).data(), &mode, magic_enum::enum_integer(i))) {
+                rendering_mode = i;
+            }
+        }
+
+        switch (rendering_mode) {
+        case Core::RenderingMode::DIRECT: {
+            ImGui::Text("Draw calls: %zu", direct_draw_calls);
+        } break;
+        case Core::RenderingMode::INSTANCED: {
+            const auto &stats = instanced_renderer.getStats();
+            ImGui::Text("Draw calls: %zu", stats.draw_calls);
+            ImGui::Text("Instances: %zu", stats.instances);
+        } break;
+        case Core::RenderingMode::INDIRECT: {
+            const auto &stats = indirect_renderer.getStats();
+            const auto &arena = indirect_renderer.getArena().getStats();
+            ImGui::Text("Multi draw calls: %zu", stats.multi_draws);
+            ImGui::Text("Commands: %zu", stats.commands);
+            ImGui::Text("Draws: %zu", stats.draws);
+            ImGui::Text("Rejected: %zu", stats.rejected);
+            ImGui::Text("Arena meshes: %zu", arena.meshes);
+            ImGui::Text("Arena vertices: %zu", arena.vertices);
+            ImGui::Text("Arena indices: %zu", arena.indices);
+        } break;
+        }
+
+        ImGui::Separator();
+
+        const auto &state_stats = state_tracker.getStats();
+        ImGui::Text("GL calls issued: %zu", state_stats.issued);
+        ImGui::Text("GL calls elided: %zu", state_stats.elided);
+        ImGui::Text("Program binds: %zu", state_stats.programs);
+        ImGui::Text("Vertex array binds: %zu", state_stats.vertex_arrays);
+        ImGui::Text("Buffer binds: %zu", state_stats.buffers);
+        ImGui::Text("State changes: %zu", state_stats.states);
+        ImGui::Text("Clears: %zu", state_stats.clears);
+        ImGui::Text("Draws: %zu", state_stats.draws);
+
+        ImGui::Separator();
+
+        ImGui::Text("Transform Kernel ");
+        auto isa = magic_enum::enum_integer(transforms.getISA());
+        for (const auto &i : magic_enum::enum_values<simd::ISA>()) {
+            if (!simd::is_supported(i)) { continue; }
+            ImGui::SameLine();
+            if (ImGui::RadioButton(magic_enum::enum_name(i).data(), &isa, magic_enum::enum_integer(i))) {
+                transforms.setISA(i);
+            }
+        }
+        ImGui::Text("Transforms computed: %zu", transforms.getStats().computed);
+        ImGui::Text("Transforms uploaded: %zu", transforms.getStats().uploaded);
+
+        ImGui::Separator();
+
+        auto culling_enabled = culling.isEnabled();
+        if (ImGui::Checkbox("Frustum culling", &culling_enabled)) { culling.setEnabled(culling_enabled); }
+        const auto &culling_stats = culling.getStats();
+        ImGui::Text("Visible: %zu", culling_stats.visible);
+        ImGui::Text("Culled: %zu", culling_stats.culled);
+        ImGui::Text("Bounds reinserted: %zu", culling_stats.reinserted);
+        ImGui::Text("Tree height: %d", culling_stats.height);
+
+        ImGui::Separator();
+
+        auto occlusion_enabled = occlusion.isEnabled();
+        if (ImGui::Checkbox("Occlusion culling", &occlusion_enabled)) {
+            occlusion.setEnabled(occlusion_enabled);
+        }
+        const auto &occlusion_stats = occlusion.getStats();
+        ImGui::Text("Occluders: %zu", occlusion_stats.occluders);
+        ImGui::Text("Occluder triangles: %zu", occlusion_stats.triangles);
+        ImGui::Text("Tested: %zu", occlusion_stats.tested);
+        ImGui::Text("Occluded: %zu", occlusion_stats.occluded);
+        const auto raster_time = std::chrono::duration<double, std::milli>{occlusion_stats.raster_time};
+        ImGui::Text("Rasterization: %.3f ms", raster_time.count());
+
+        ImGui::Separator();
+
+        auto lods_enabled = lods.isEnabled();
+        if (ImGui::Checkbox("Level of detail", &lods_enabled)) { lods.setEnabled(lods_enabled); }
+        const auto &lod_stats = lods.getStats();
+        for (std::size_t i = 0; i != lod_stats.entities.size(); i++) {
+            ImGui::Text("Level %zu: %zu", i, lod_stats.entities[i]);
+        }
+        ImGui::Text("Triangles: %zu / %zu", lod_stats.triangles, lod_stats.full_triangles);
+
+        ImGui::Separator();
+
+        const auto &batch_stats = static_batcher.getStats();
+        ImGui::Text("Static batches: %zu", batch_stats.batches);
+        ImGui::Text("Static entities: %zu", batch_stats.members);
+        ImGui::Text("Static vertices: %zu", batch_stats.vertices);
+        ImGui::Text("Static indices: %zu", batch_stats.indices);
+        ImGui::Text("Static draw calls: %zu", batch_stats.draw_calls);
+        ImGui::Text("Static entities written: %zu", batch_stats.written);
+        ImGui::Text("Static batches repacked: %zu", batch_stats.repacked);
+
+        ImGui::Separator();
+
+        const auto &ring_stats = ring_buffer.getStats();
+        ImGui::Text("Ring buffer: %zu / %zu bytes", ring_stats.allocated, ring_buffer.getFrameSize());
+        ImGui::Text("Ring buffer overflows: %zu", ring_stats.overflows);
+        ImGui::Text("Ring buffer stalls: %zu", ring_stats.stalls);
+        const auto stall_time = std::chrono::duration<double, std::milli>{ring_stats.stall_time};
+        ImGui::Text("Ring buffer stall time: %.3f ms", stall_time.count());
+
+        ImGui::Separator();
+
+        const auto &pool_stats = object_pool.getStats();
+        ImGui::Text("GL objects created: %zu", pool_stats.created);
+        ImGui::Text("GL objects deleted: %zu", pool_stats.deleted);
+        ImGui::Text("GL objects calls: %zu", pool_stats.calls);
+        ImGui::Text("GL objects free: %zu", pool_stats.free);
+        ImGui::Text("GL objects pending: %zu", pool_stats.pending);
+
+        ImGui::Separator();
+
+        const auto &allocator_stats = buffer_allocator.getStats();
+        ImGui::Text("Mesh buffer blocks: %zu", allocator_stats.blocks);
+        ImGui::Text("Mesh buffer ranges: %zu", allocator_stats.allocations);
+        ImGui::Text("Mesh buffer used: %zu / %zu bytes", allocator_stats.used, allocator_stats.reserved);
+        ImGui::Text("Mesh buffer free ranges: %zu", allocator_stats.free_ranges);
+        ImGui::Text("Mesh buffer largest free: %zu bytes", allocator_stats.largest_free);
+        ImGui::Text("Mesh buffer pending: %zu", allocator_stats.pending);
+        ImGui::Text("Mesh buffer fragmentation: %.3f", allocator_stats.fragmentation());
+        if (ImGui::Button("Defragment")) { defragment = true; }
+    }
+};
+
+} // namespace widget
+
+} // namespace core
+} // namespace engine
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <map>
 
 #include <spdlog/spdlog.h>
 #include <fmt/format.h>
@@ -16,14 +17,42 @@
 
 #include "Engine/Camera.hpp"
 #include "Engine/graphics/Shader.hpp"
+#include "Engine/graphics/FrameUniforms.hpp"
+#include "Engine/graphics/DebugMessages.hpp"
+#include "Engine/graphics/GpuProfiler.hpp"
+#include "Engine/graphics/FramePacer.hpp"
+#include "Engine/graphics/ProgramCache.hpp"
+#include "Engine/graphics/IndirectRenderer.hpp"
+#include "Engine/graphics/InstancedRenderer.hpp"
+#include "Engine/graphics/StaticBatcher.hpp"
+#include "Engine/system/TransformSystem.hpp"
+#include "Engine/system/CullingSystem.hpp"
+#include "Engine/system/OcclusionSystem.hpp"
+#include "Engine/system/LODSystem.hpp"
 #include "Engine/json/Event.hpp"
 
 #include "Engine/widget/DisplayOption.hpp"
 #include "Engine/widget/ComponentTree.hpp"
 #include "Engine/widget/CameraWidget.hpp"
+#include "Engine/widget/RendererWidget.hpp"
+#include "Engine/widget/ProfilerWidget.hpp"
+#include "Engine/widget/FramePacerWidget.hpp"
 
+#include "Engine/helpers/optional.hpp"
 #include "Engine/helpers/overloaded.hpp"
 
+namespace {
+
+// entities drawn one by one, the owning group keeps their VAO and Transform packed in the same order
+// note : adding / removing a Member or a Transform reorders these pools, a pointer to them is not stable
+auto group_renderables(entt::registry &world)
+{
+    return world.group<engine::api::VAO, engine::api::Transform>(
+        entt::exclude<engine::core::StaticBatcher::Member>);
+}
+
+} // namespace
+
 auto engine::core::Core::main([[maybe_unused]] int argc, [[maybe_unused]] char **argv) -> int
 {
     spdlog::set_level(spdlog::level::trace);
@@ -31,10 +60,52 @@ auto engine::core::Core::main([[maybe_unused]] int argc, [[maybe_unused]] char *
     spdlog::info("{} - v{}", PROJECT_NAME, PROJECT_VERSION);
 
     std::string module_name{"default"};
-    int glfw_major = 3;
-    int glfw_minor = 3;
+    int glfw_major = 4;
+    int glfw_minor = 5;
     int window_width = 300;
     int window_height = 300;
+    auto rendering_mode = RenderingMode::DIRECT;
+    bool headless{false};
+    auto context_api = ContextAPI::NATIVE;
+    std::size_t frames{0};
+    std::string capture_dir;
+    std::string profile_csv;
+    std::string shader_cache{"cache/shaders"};
+    auto capture_format = ImageEncoder::Format::PNG;
+    double max_fps{0.0};
+    auto vsync = FramePacer::VSync::ADAPTIVE;
+    std::size_t frames_in_flight{2};
+    double defragment_threshold{0.5};
+#ifndef NDEBUG
+    auto gl_debug = DebugOutput::SYNCHRONOUS;
+#else
+    auto gl_debug = DebugOutput::POLL;
+#endif
+
+    std::map<std::string, RenderingMode> rendering_modes;
+    for (const auto &i : magic_enum::enum_values<RenderingMode>()) {
+        rendering_modes.emplace(magic_enum::enum_name(i), i);
+    }
+
+    std::map<std::string, ContextAPI> context_apis;
+    for (const auto &i : magic_enum::enum_values<ContextAPI>()) {
+        context_apis.emplace(magic_enum::enum_name(i), i);
+    }
+
+    std::map<std::string, ImageEncoder::Format> capture_formats;
+    for (const auto &i : magic_enum::enum_values<ImageEncoder::Format>()) {
+        capture_formats.emplace(magic_enum::enum_name(i), i);
+    }
+
+    std::map<std::string, DebugOutput> gl_debug_outputs;
+    for (const auto &i : magic_enum::enum_values<DebugOutput>()) {
+        gl_debug_outputs.emplace(magic_enum::enum_name(i), i);
+    }
+
+    std::map<std::string, FramePacer::VSync> vsyncs;
+    for (const auto &i : magic_enum::enum_values<FramePacer::VSync>()) {
+        vsyncs.emplace(magic_enum::enum_name(i), i);
+    }
 
     CLI::App app{PROJECT_NAME " description", argv[0]};
     app.set_config("--config", "engine-config.ini");
@@ -43,6 +114,32 @@ auto engine::core::Core::main([[maybe_unused]] int argc, [[maybe_unused]] char *
     app.add_option("--glfw-minor", glfw_minor, "Minor version of GLFW.");
     app.add_option("--window-width", window_width, "Initial width of the rendering window.");
     app.add_option("--window-height", window_height, "Initial height of the rendering window.");
+    app.add_option("--rendering-mode", rendering_mode, "How the entities are submitted to the GPU.")
+        ->transform(CLI::CheckedTransformer(rendering_modes, CLI::ignore_case));
+    app.add_flag(
+        "--headless",
+        headless,
+        "Render into an offscreen framebuffer of --window-width x --window-height, no display is needed.");
+    app.add_option("--context-api", context_api, "API creating the context, EGL by default when headless.")
+        ->transform(CLI::CheckedTransformer(context_apis, CLI::ignore_case));
+    app.add_option("--gl-debug", gl_debug, "How the GL errors are reported, POLL checks after every call.")
+        ->transform(CLI::CheckedTransformer(gl_debug_outputs, CLI::ignore_case));
+    app.add_option("--max-fps", max_fps, "Frame rate limit, 0 means unlimited.");
+    app.add_option("--vsync", vsync, "Synchronization of the presentation with the display.")
+        ->transform(CLI::CheckedTransformer(vsyncs, CLI::ignore_case));
+    app.add_option("--frames-in-flight", frames_in_flight, "Frames queued on the GPU before the CPU waits.")
+        ->check(CLI::Range(std::size_t{1}, FramePacer::MAX_FRAMES_IN_FLIGHT));
+    app.add_option(
+           "--defragment-threshold",
+           defragment_threshold,
+           "Fragmentation of the mesh buffers above which they are compacted, 0 disables it.")
+        ->check(CLI::Range(0.0, 1.0));
+    app.add_option("--frames", frames, "Number of frames to render before exiting, 0 means unlimited.");
+    app.add_option("--capture-dir", capture_dir, "Record every frame in this directory.");
+    app.add_option("--capture-format", capture_format, "Image format of the recorded frames.")
+        ->transform(CLI::CheckedTransformer(capture_formats, CLI::ignore_case));
+    app.add_option("--shader-cache", shader_cache, "Directory of the program binaries, empty to disable.");
+    app.add_option("--profile-csv", profile_csv, "Write the CPU and GPU timings of each frame in this file.");
     app.add_flag(
         "--version",
         [](auto v) -> void {
@@ -55,7 +152,18 @@ auto engine::core::Core::main([[maybe_unused]] int argc, [[maybe_unused]] char *
 
     CLI11_PARSE(app, argc, argv);
 
+    if (headless && app.count("--context-api") == 0) { context_api = ContextAPI::EGL; }
+    // note : nothing is presented when headless
+    if (headless && app.count("--vsync") == 0) { vsync = FramePacer::VSync::OFF; }
+
     Core core{};
+    core.m_rendering_mode = rendering_mode;
+    core.m_profile_csv = profile_csv;
+    core.m_max_fps = max_fps;
+    core.m_vsync = vsync;
+    core.m_frames_in_flight = frames_in_flight;
+    core.m_defragment_threshold = defragment_threshold;
+    ProgramCache::get().setDirectory(shader_cache);
 
     if (const auto module_obj = core.load_module(module_name)) {
         core.m_module = module_obj;
@@ -64,19 +172,36 @@ auto engine::core::Core::main([[maybe_unused]] int argc, [[maybe_unused]] char *
         return 1;
     }
 
-    if (!core.initialize_graphics(glfw_major, glfw_minor)) {
+    if (!core.initialize_graphics(glfw_major, glfw_minor, context_api, gl_debug, headless)) {
         spdlog::error("Initialization of graphical context failed...");
         return 1;
     }
 
-    core.m_window = std::make_unique<Window>(window_width, window_height, PROJECT_NAME " - Rendering window");
+    core.m_window =
+        std::make_unique<Window>(window_width, window_height, PROJECT_NAME " - Rendering window", headless);
+    core.m_window->setFrameLimit(frames);
     core.m_event_manager.registerWindow(*core.m_window);
 
-    if (const auto err = ::glewInit(); err != GLEW_OK) {
+    // note : the surfaceless contexts have no GLX display, the GL functions are loaded all the same
+    if (const auto err = ::glewInit(); err != GLEW_OK && !(headless && err == GLEW_ERROR_NO_GLX_DISPLAY)) {
         spdlog::error("Engine::Core GLEW An error occured '{}' 'code={}'", ::glewGetErrorString(err), err);
         return 1;
     }
 
+    // note : before any other GL call, so the errors of the initialization are reported by the callback
+    const auto debug_mode = install_debug_messages(gl_debug);
+    spdlog::info("Engine::Core GL errors reported by {}", magic_enum::enum_name(debug_mode));
+
+    if (headless && !core.m_window->create_offscreen_target()) {
+        spdlog::error("Engine::Core failed to create the offscreen framebuffer");
+        return 1;
+    }
+
+    if (!capture_dir.empty() && !core.m_window->record(capture_dir, capture_format)) {
+        spdlog::error("Engine::Core could not record in '{}'", capture_dir);
+        return 1;
+    }
+
     if (!core.m_window->create_ui_context()) {
         spdlog::error("Engine::Core ImGui failed to create context");
         return 1;
@@ -84,124 +209,69 @@ auto engine::core::Core::main([[maybe_unused]] int argc, [[maybe_unused]] char *
 
     spdlog::info("{}", core.m_module->name());
 
-    ::glfwSwapInterval(0);
-
     core.loop();
+
+    if (headless) {
+        spdlog::info("Engine::Core {} frames rendered offscreen", core.m_window->getFrameCount());
+    }
+
     return 0;
 }
 
-engine::core::Core::~Core() { ::glfwTerminate(); }
+engine::core::Core::~Core()
+{
+    // note : the window flushes its pending readbacks and deletes its GL objects, the context must still exist
+    m_window.reset();
+    ::glfwTerminate();
+}
 
-auto engine::core::Core::system_rendering(Shader &shader, entt::registry &world) const noexcept
+auto engine::core::Core::system_rendering(
+    Shader &shader,
+    entt::registry &world,
+    const Camera &camera,
+    const CullingSystem &culling,
+    OcclusionSystem &occlusion,
+    RenderQueue &queue,
+    StateTracker &state) const
 {
-    const auto render =
-        [&shader]<bool has_ebo>(
-            const api::VAO &vao, const api::Position3f &pos, const api::Rotation3f &rot, const api::Scale3f &scale) {
-            auto model = glm::mat4(1.0f);
-            model = glm::translate(model, pos.vec);
-            model = glm::rotate(model, glm::radians(rot.vec.x), glm::vec3(1.0f, 0.0f, 0.0f));
-            model = glm::rotate(model, glm::radians(rot.vec.y), glm::vec3(0.0f, 1.0f, 0.0f));
-            model = glm::rotate(model, glm::radians(rot.vec.z), glm::vec3(0.0f, 0.0f, 1.0f));
-            model = glm::scale(model, scale.vec);
-            shader.setUniform("model", model);
-
-            CALL_OPEN_GL(::glBindVertexArray(vao.object));
-            if constexpr (has_ebo) {
-                CALL_OPEN_GL(::glDrawElements(static_cast<GLenum>(vao.mode), vao.count, GL_UNSIGNED_INT, 0));
-            } else {
-                CALL_OPEN_GL(::glDrawArrays(static_cast<GLenum>(vao.mode), 0, vao.count));
-            }
-        };
-
-    [[maybe_unused]] static constexpr auto NO_POSITION = glm::vec3{0.0f, 0.0f, 0.0f};
-    [[maybe_unused]] static constexpr auto NO_ROTATION = glm::vec3{0.0f, 0.0f, 0.0f};
-    [[maybe_unused]] static constexpr auto NO_SCALE = glm::vec3{1.0f, 1.0f, 1.0f};
-
-    // note : it should be a better way..
-
-    // without ebo
-
-    world.view<api::VAO>(entt::exclude<api::EBO, api::Position3f, api::Rotation3f, api::Scale3f>)
-        .each([&render](const auto &vao) {
-            render.operator()<false>(vao, {NO_POSITION}, {NO_ROTATION}, {NO_SCALE});
-        });
-
-    world.view<api::VAO, api::Position3f>(entt::exclude<api::EBO, api::Rotation3f, api::Scale3f>)
-        .each([&render](const auto &vao, const auto &pos) {
-            render.operator()<false>(vao, pos, {NO_ROTATION}, {NO_SCALE});
-        });
-
-    world.view<api::VAO, api::Rotation3f>(entt::exclude<api::EBO, api::Position3f, api::Scale3f>)
-        .each([&render](const auto &vao, const auto &rot) {
-            render.operator()<false>(vao, {NO_POSITION}, rot, {NO_SCALE});
-        });
-
-    world.view<api::VAO, api::Scale3f>(entt::exclude<api::EBO, api::Position3f, api::Rotation3f>)
-        .each([&render](const auto &vao, const auto &scale) {
-            render.operator()<false>(vao, {NO_POSITION}, {NO_ROTATION}, scale);
-        });
-
-    world.view<api::VAO, api::Position3f, api::Scale3f>(entt::exclude<api::EBO, api::Rotation3f>)
-        .each([&render](const auto &vao, const auto &pos, const auto &scale) {
-            render.operator()<false>(vao, pos, {NO_ROTATION}, scale);
-        });
-
-    world.view<api::VAO, api::Rotation3f, api::Scale3f>(entt::exclude<api::EBO, api::Position3f>)
-        .each([&render](const auto &vao, const auto &rot, const auto &scale) {
-            render.operator()<false>(vao, {NO_POSITION}, rot, scale);
-        });
-
-    world.view<api::VAO, api::Position3f, api::Rotation3f>(entt::exclude<api::EBO, api::Scale3f>)
-        .each([&render](const auto &vao, const auto &pos, const auto &rot) {
-            render.operator()<false>(vao, pos, rot, {NO_SCALE});
-        });
-
-    world.view<api::VAO, api::Position3f, api::Rotation3f, api::Scale3f>(entt::exclude<api::EBO>)
-        .each([&render](const auto &vao, const auto &pos, const auto &rot, const auto &scale) {
-            render.operator()<false>(vao, pos, rot, scale);
-        });
-
-    // with ebo
-
-    world.view<api::EBO, api::VAO>(entt::exclude<api::Position3f, api::Rotation3f, api::Scale3f>)
-        .each([&render](const auto &, const auto &vao) {
-            render.operator()<true>(vao, {NO_POSITION}, {NO_ROTATION}, {NO_SCALE});
-        });
-
-    world.view<api::EBO, api::VAO, api::Position3f>(entt::exclude<api::Rotation3f, api::Scale3f>)
-        .each([&render](const auto &, const auto &vao, const auto &pos) {
-            render.operator()<true>(vao, pos, {NO_ROTATION}, {NO_SCALE});
-        });
-
-    world.view<api::EBO, api::VAO, api::Rotation3f>(entt::exclude<api::Position3f, api::Scale3f>)
-        .each([&render](const auto &, const auto &vao, const auto &rot) {
-            render.operator()<true>(vao, {NO_POSITION}, rot, {NO_SCALE});
-        });
-
-    world.view<api::EBO, api::VAO, api::Scale3f>(entt::exclude<api::Position3f, api::Rotation3f>)
-        .each([&render](const auto &, const auto &vao, const auto &scale) {
-            render.operator()<true>(vao, {NO_POSITION}, {NO_ROTATION}, scale);
-        });
-
-    world.view<api::EBO, api::VAO, api::Position3f, api::Scale3f>(entt::exclude<api::Rotation3f>)
-        .each([&render](const auto &, const auto &vao, const auto &pos, const auto &scale) {
-            render.operator()<true>(vao, pos, {NO_ROTATION}, scale);
-        });
-
-    world.view<api::EBO, api::VAO, api::Rotation3f, api::Scale3f>(entt::exclude<api::Position3f>)
-        .each([&render](const auto &, const auto &vao, const auto &rot, const auto &scale) {
-            render.operator()<true>(vao, {NO_POSITION}, rot, scale);
-        });
-
-    world.view<api::EBO, api::VAO, api::Position3f, api::Rotation3f>(entt::exclude<api::Scale3f>)
-        .each([&render](const auto &, const auto &vao, const auto &pos, const auto &rot) {
-            render.operator()<true>(vao, pos, rot, {NO_SCALE});
-        });
-
-    world.view<api::EBO, api::VAO, api::Position3f, api::Rotation3f, api::Scale3f>().each(
-        [&render](const auto &, const auto &vao, const auto &pos, const auto &rot, const auto &scale) {
-            render.operator()<true>(vao, pos, rot, scale);
-        });
+    static constexpr auto NO_TINT = api::Tint4f{glm::vec4{1.0f, 1.0f, 1.0f, 1.0f}};
+    static constexpr auto MODEL = entt::hashed_string{"model"};
+    static constexpr auto TINT = entt::hashed_string{"tint"};
+
+    const auto model = shader.getUniform<glm::mat4>(MODEL);
+    const auto tint = shader.getUniform<glm::vec4>(TINT);
+
+    queue.clear();
+
+    const auto renderables = group_renderables(world);
+    const Optional<api::EBO, api::Tint4f, api::LOD> optional{world};
+
+    // note : a single pass over the packed VAO and Transform, the other components are looked up when present
+    renderables.each([&shader, &camera, &culling, &occlusion, &queue, &optional](
+                         const auto entity, const api::VAO &vao, const api::Transform &transform) {
+        if (!culling.isVisible(entity) || !occlusion.test(entity)) { return; }
+
+        // note : only the tint tells if the entity is translucent, the vertex colors are not inspected
+        const auto color = optional.find<api::Tint4f>(entity);
+        const auto pass =
+            color && color->vec.a < 1.0f ? RenderQueue::Pass::TRANSLUCENT : RenderQueue::Pass::SOLID;
+        const auto position = glm::vec3{transform.world[3]};
+        const auto depth = glm::distance(camera.getPosition(), position) / camera.getFar();
+        const auto level = LODSystem::select(vao, optional.find<api::LOD>(entity));
+        const auto indexed = optional.has<api::EBO>(entity);
+        queue.push(
+            pass,
+            depth,
+            vao.content_hash,
+            {&shader, vao.object, vao.mode, level.first, level.count, indexed, entity});
+    });
+
+    queue.sort();
+
+    return queue.submit(state, [&renderables, &optional, &model, &tint](const RenderQueue::Draw &draw) {
+        draw.shader->setUniform(model, renderables.get<api::Transform>(draw.entity).world);
+        draw.shader->setUniform(tint, optional.get<api::Tint4f>(draw.entity, NO_TINT).vec);
+    });
 }
 
 auto engine::core::Core::loop() -> void
@@ -210,17 +280,24 @@ auto engine::core::Core::loop() -> void
 layout (location = 0) in vec3 inPos;
 layout (location = 1) in vec4 inColors;
 
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    vec4 camera_position;
+    float time;
+};
+
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+uniform vec4 tint = vec4(1.0f);
 
 out vec4 fragColors;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(inPos, 1.0f);
+    gl_Position = view_projection * model * vec4(inPos, 1.0f);
 
-    fragColors = inColors;
+    fragColors = inColors * tint;
 }
 )";
 
@@ -235,22 +312,39 @@ void main()
 }
 )";
 
-    CALL_OPEN_GL(::glEnable(GL_DEPTH_TEST));
-    CALL_OPEN_GL(::glEnable(GL_BLEND));
-    CALL_OPEN_GL(::glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
-
-
     Shader shader(VERT_SH, FRAG_SH);
-    shader.use();
 
     entt::registry world;
 #define SET_DESTRUCTOR(Type) world.on_destroy<Type>().connect<Type::on_destroy>()
     SET_DESTRUCTOR(api::VAO);
-    SET_DESTRUCTOR(api::VBO<api::VAO::Attribute::POSITION>);
-    SET_DESTRUCTOR(api::VBO<api::VAO::Attribute::COLOR>);
+    SET_DESTRUCTOR(api::Vertices);
     SET_DESTRUCTOR(api::EBO);
+    SET_DESTRUCTOR(api::LOD);
 #undef SET_DESTRUCTOR
 
+    // note : shared with the modules through the context of the registry
+    constexpr auto RING_BUFFER_FRAME_SIZE = std::size_t{4} * 1024 * 1024;
+    auto &ring_buffer = world.set<api::RingBuffer>(RING_BUFFER_FRAME_SIZE);
+    auto &object_pool = world.set<api::ObjectPool>();
+    auto &buffer_allocator = world.set<api::BufferAllocator>(object_pool);
+    world.set<api::BufferCache>(buffer_allocator);
+
+    FrameUniforms frame_uniforms;
+    TransformSystem transforms{world};
+    CullingSystem culling{world};
+    OcclusionSystem occlusion{world};
+    LODSystem lods{world};
+    StaticBatcher static_batcher{world};
+    InstancedRenderer instanced_renderer{world};
+    IndirectRenderer indirect_renderer;
+    ProgramCache::get().log();
+    RenderQueue render_queue;
+    StateTracker state_tracker;
+    std::size_t direct_draw_calls{0};
+    GpuProfiler profiler{m_profile_csv};
+    FramePacer pacer{m_max_fps, m_frames_in_flight};
+    pacer.setVSync(m_vsync);
+
     std::unique_ptr<api::Scene> scene{nullptr};
 
     if (m_module->getCategory() == api::Module::Category::SCENE) {
@@ -262,10 +356,14 @@ void main()
         return;
     }
 
+    // note : created before the entities, the group is then filled as they are instead of on the first draw
+    group_renderables(world);
+
     scene->onCreate(world);
 
     auto display_mode = api::VAO::DEFAULT_MODE;
     bool camera_auto_move{true};
+    bool defragment{false};
 
     Camera camera{*m_window, glm::vec3{5, 5, 5}};
 
@@ -294,11 +392,47 @@ void main()
           }},
          {"Camera",
           true,
-          [widget = widget::CameraWidget{shader, camera}, &camera_auto_move](bool &is_displayed) {
+          [widget = widget::CameraWidget{camera}, &camera_auto_move](bool &is_displayed) {
               ImGui::Begin("Camera", &is_displayed);
               widget.draw(camera_auto_move);
               ImGui::End();
           }},
+         {"Renderer",
+          false,
+          [widget = widget::RendererWidget{
+               m_rendering_mode,
+               direct_draw_calls,
+               state_tracker,
+               instanced_renderer,
+               indirect_renderer,
+               transforms,
+               culling,
+               occlusion,
+               lods,
+               static_batcher,
+               ring_buffer,
+               object_pool,
+               buffer_allocator,
+               defragment}](
+              bool &is_displayed) {
+              ImGui::Begin("Renderer", &is_displayed);
+              widget.draw();
+              ImGui::End();
+          }},
+         {"Profiler",
+          false,
+          [widget = widget::ProfilerWidget{profiler}](bool &is_displayed) {
+              ImGui::Begin("Profiler", &is_displayed);
+              widget.draw();
+              ImGui::End();
+          }},
+         {"Frame Pacing",
+          false,
+          [widget = widget::FramePacerWidget{pacer}](bool &is_displayed) {
+              ImGui::Begin("Frame Pacing", &is_displayed);
+              widget.draw();
+              ImGui::End();
+          }},
          {"Events", true, [&](bool &is_displayed) {
               ImGui::Begin("Events", &is_displayed);
               ImGui::Text("Number of Event processed: %ld", m_event_manager.getEventsProcessed().size());
@@ -404,50 +538,125 @@ void main()
                      std::cos(static_cast<float>(timeElapsedSinceBegining) / 1000.0f) * radius * 3.0f});
             }
 
-            ImGui_ImplOpenGL3_NewFrame();
-            ImGui_ImplGlfw_NewFrame();
-            ImGui::NewFrame();
+            profiler.beginFrame();
+
+            {
+                const auto profile_ui = profiler.scope("UI build");
+
+                ImGui_ImplOpenGL3_NewFrame();
+                ImGui_ImplGlfw_NewFrame();
+                ImGui::NewFrame();
+
+                scene->onDrawUI();
+
+                ImGui::Begin("Debug Panel", nullptr);
+                for (auto &[name, is_displayed, _] : debugWidget) {
+                    ImGui::Checkbox(name.data(), &is_displayed);
+                }
+                ImGui::End();
+
+                for (auto &[_, is_displayed, func] : debugWidget) {
+                    if (is_displayed) { func(is_displayed); }
+                }
+
+                ImGui::Render();
+            }
+
+            frame_uniforms.update(camera, static_cast<float>(timeElapsedSinceBegining) / 1000.0f);
 
-            scene->onDrawUI();
+            state_tracker.newFrame();
 
-            ImGui::Begin("Debug Panel", nullptr);
-            for (auto &[name, is_displayed, _] : debugWidget) { ImGui::Checkbox(name.data(), &is_displayed); }
-            ImGui::End();
+            {
+                const auto profile_clear = profiler.scope("Clear");
 
-            for (auto &[_, is_displayed, func] : debugWidget) {
-                if (is_displayed) { func(is_displayed); }
+                constexpr auto CLEAR_COLOR = glm::vec4{0.0f, 1.0f, 0.2f, 1.0f};
+
+                // note : set each frame, the cached state is forgotten at the start of the frame
+                state_tracker.enable(GL_DEPTH_TEST, true);
+                state_tracker.enable(GL_BLEND, true);
+                state_tracker.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                state_tracker.clearColor(CLEAR_COLOR);
+                state_tracker.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             }
 
-            ImGui::Render();
+            {
+                const auto profile_update = profiler.scope("Transforms, culling & LOD");
 
-            if (camera.hasChanged<Camera::Matrix::VIEW>()) {
-                const auto view = glm::lookAt(camera.getPosition(), camera.getTargetCenter(), camera.getUp());
-                shader.setUniform("view", view);
-                camera.setChangedFlag<Camera::Matrix::VIEW>(false);
+                transforms.update();
+                culling.update(frame_uniforms.getBlock().view_projection);
+                lods.update(frame_uniforms.getBlock(), culling);
             }
 
-            if (camera.hasChanged<Camera::Matrix::PROJECTION>()) {
-                const auto projection = camera.getProjection();
-                shader.setUniform("projection", projection);
-                camera.setChangedFlag<Camera::Matrix::PROJECTION>(false);
+            // note : only the direct rendering tests the entities against the occluders
+            if (m_rendering_mode == RenderingMode::DIRECT) {
+                const auto profile_occlusion = profiler.scope("Occlusion");
+
+                occlusion.update(frame_uniforms.getBlock().view_projection, culling);
             }
 
-            constexpr auto CLEAR_COLOR = glm::vec4{0.0f, 1.0f, 0.2f, 1.0f};
+            {
+                const auto profile_batching = profiler.scope("Static batching");
+
+                static_batcher.update();
+            }
 
-            CALL_OPEN_GL(::glClearColor(CLEAR_COLOR.r, CLEAR_COLOR.g, CLEAR_COLOR.b, CLEAR_COLOR.a));
-            CALL_OPEN_GL(::glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+            {
+                const auto profile_scene = profiler.scope("Scene");
+
+                static_batcher.draw(frame_uniforms.getBlock().view_projection, state_tracker);
+
+                switch (m_rendering_mode) {
+                case RenderingMode::DIRECT:
+                    direct_draw_calls = system_rendering(
+                        shader, world, camera, culling, occlusion, render_queue, state_tracker);
+                    break;
+                case RenderingMode::INSTANCED:
+                    instanced_renderer.draw(world, transforms, culling, ring_buffer, state_tracker);
+                    break;
+                case RenderingMode::INDIRECT:
+                    indirect_renderer.draw(world, transforms, culling, state_tracker);
+                    break;
+                }
+            }
 
-            system_rendering(shader, world);
+            {
+                const auto profile_ui = profiler.scope("UI draw");
 
-            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            }
 
             m_window->render();
+
+            ring_buffer.advance();
+            object_pool.advance();
+            buffer_allocator.advance();
+
+            // note : compacted between two frames, not before the ranges moved by the previous pass are freed
+            const auto &allocator_stats = buffer_allocator.getStats();
+            const auto fragmented = m_defragment_threshold > 0.0 && allocator_stats.pending == 0
+                                    && allocator_stats.fragmentation() > m_defragment_threshold
+                                    && allocator_stats.reserved - allocator_stats.used
+                                           >= api::BufferAllocator::BLOCK_SIZE;
+            if (defragment || fragmented) {
+                const auto moved = api::defragment(world);
+                spdlog::info("engine::core::Core: {} buffers moved by the defragmentation", moved);
+                defragment = false;
+            }
+
+            pacer.setIdle(m_window->isIconified());
+            pacer.endFrame();
         }
     }
 
     scene->onDestroy();
 
     world.clear();
+
+    // note : the buffers of the cache give their ranges back to the allocator, which gives its blocks back to
+    // the pool, so the pool is destroyed last
+    world.unset<api::BufferCache>();
+    world.unset<api::BufferAllocator>();
+    world.unset<api::ObjectPool>();
 }
 
 auto engine::core::Core::load_module(const std::string_view name) -> const api::Module *
@@ -465,17 +674,32 @@ try {
     return nullptr;
 }
 
-auto engine::core::Core::initialize_graphics(int glfw_context_major, int glfw_context_minor) -> bool
+auto engine::core::Core::initialize_graphics(
+    int glfw_context_major,
+    int glfw_context_minor,
+    ContextAPI context_api,
+    DebugOutput gl_debug,
+    bool headless) -> bool
 {
     ::glfwSetErrorCallback([](int code, const char *message) {
         spdlog::error("engine::core::Core [GLFW] An error occured '{}' 'code={}'\n", message, code);
     });
 
+    // note : the null platform does not connect to any display, the context is surfaceless EGL or OSMesa
+    if (headless) { ::glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL); }
+
     if (::glfwInit() == GLFW_FALSE) { return false; }
 
     ::glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, glfw_context_major);
     ::glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, glfw_context_minor);
     ::glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    switch (context_api) {
+    case ContextAPI::NATIVE: ::glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API); break;
+    case ContextAPI::EGL: ::glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API); break;
+    case ContextAPI::OSMESA: ::glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API); break;
+    }
+    // note : the drivers only have to report the messages of a debug context
+    ::glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, gl_debug == DebugOutput::POLL ? GLFW_FALSE : GLFW_TRUE);
 #ifdef __APPLE__
     ::glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
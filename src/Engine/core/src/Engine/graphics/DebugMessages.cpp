@@ -0,0 +1,88 @@
+#include <array>
+#include <string_view>
+
+#include <spdlog/spdlog.h>
+
+#include "Engine/graphics/DebugMessages.hpp"
+
+namespace {
+
+constexpr auto source_name(GLenum source) noexcept -> std::string_view
+{
+    switch (source) {
+    case GL_DEBUG_SOURCE_API: return "api";
+    case GL_DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+    case GL_DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+    case GL_DEBUG_SOURCE_THIRD_PARTY: return "third party";
+    case GL_DEBUG_SOURCE_APPLICATION: return "application";
+    default: return "other";
+    }
+}
+
+constexpr auto type_name(GLenum type) noexcept -> std::string_view
+{
+    switch (type) {
+    case GL_DEBUG_TYPE_ERROR: return "error";
+    case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+    case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+    case GL_DEBUG_TYPE_PORTABILITY: return "portability";
+    case GL_DEBUG_TYPE_PERFORMANCE: return "performance";
+    case GL_DEBUG_TYPE_MARKER: return "marker";
+    default: return "other";
+    }
+}
+
+constexpr auto level(GLenum severity) noexcept -> spdlog::level::level_enum
+{
+    switch (severity) {
+    case GL_DEBUG_SEVERITY_HIGH: return spdlog::level::err;
+    case GL_DEBUG_SEVERITY_MEDIUM: return spdlog::level::warn;
+    case GL_DEBUG_SEVERITY_LOW: return spdlog::level::info;
+    default: return spdlog::level::debug;
+    }
+}
+
+// note : may be called from a driver thread in ASYNCHRONOUS, the spdlog loggers are thread safe
+auto GLAPIENTRY on_message(
+    GLenum source,
+    GLenum type,
+    GLuint id,
+    GLenum severity,
+    GLsizei length,
+    const GLchar *message,
+    [[maybe_unused]] const void *user) -> void
+{
+    const auto text =
+        length < 0 ? std::string_view{message} : std::string_view{message, static_cast<std::size_t>(length)};
+    spdlog::log(level(severity), "OPEN_GL [{} {} {}]: {}", source_name(source), type_name(type), id, text);
+}
+
+} // namespace
+
+auto engine::core::install_debug_messages(DebugOutput mode) -> DebugOutput
+{
+    debug_output = DebugOutput::POLL;
+    if (mode == DebugOutput::POLL) { return debug_output; }
+
+    if (!GLEW_VERSION_4_3 && !GLEW_KHR_debug) {
+        spdlog::warn("engine::core::DebugMessages: KHR_debug is not supported, the GL errors are polled");
+        return debug_output;
+    }
+
+    CALL_OPEN_GL(::glEnable(GL_DEBUG_OUTPUT));
+    if (mode == DebugOutput::SYNCHRONOUS) {
+        CALL_OPEN_GL(::glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS));
+    } else {
+        CALL_OPEN_GL(::glDisable(GL_DEBUG_OUTPUT_SYNCHRONOUS));
+    }
+    CALL_OPEN_GL(::glDebugMessageCallback(on_message, nullptr));
+
+    CALL_OPEN_GL(::glDebugMessageControl(
+        GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE));
+    for (const auto type : std::to_array<GLenum>({GL_DEBUG_TYPE_PUSH_GROUP, GL_DEBUG_TYPE_POP_GROUP})) {
+        CALL_OPEN_GL(::glDebugMessageControl(GL_DONT_CARE, type, GL_DONT_CARE, 0, nullptr, GL_FALSE));
+    }
+
+    debug_output = mode;
+    return debug_output;
+}
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <numeric>
+#include <thread>
+
+#include <spdlog/spdlog.h>
+
+#include "Engine/graphics/FramePacer.hpp"
+
+engine::core::FramePacer::FramePacer(double max_fps, std::size_t frames_in_flight) :
+    m_max_fps{max_fps},
+    m_frames_in_flight{std::clamp(frames_in_flight, std::size_t{1}, MAX_FRAMES_IN_FLIGHT)}
+{
+}
+
+engine::core::FramePacer::~FramePacer()
+{
+    for (auto &fence : m_fences) {
+        if (fence) { ::glDeleteSync(fence); }
+    }
+}
+
+auto engine::core::FramePacer::setVSync(VSync vsync) -> VSync
+{
+    if (vsync == VSync::ADAPTIVE && ::glfwExtensionSupported("WGL_EXT_swap_control_tear") == GLFW_FALSE
+        && ::glfwExtensionSupported("GLX_EXT_swap_control_tear") == GLFW_FALSE) {
+        spdlog::warn("engine::core::FramePacer: adaptive vsync is not supported, using vsync");
+        vsync = VSync::ON;
+    }
+
+    switch (vsync) {
+    case VSync::OFF: ::glfwSwapInterval(0); break;
+    case VSync::ON: ::glfwSwapInterval(1); break;
+    case VSync::ADAPTIVE: ::glfwSwapInterval(-1); break;
+    }
+    m_vsync = vsync;
+    return m_vsync;
+}
+
+auto engine::core::FramePacer::endFrame() -> void
+{
+    waitGpu();
+
+    const auto fps = m_idle && (m_max_fps <= 0.0 || IDLE_FPS < m_max_fps) ? IDLE_FPS : m_max_fps;
+
+    m_stats.slept = {};
+    m_stats.spun = {};
+    if (fps > 0.0) {
+        m_deadline += std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>{1.0 / fps});
+        if (const auto now = clock::now(); m_deadline < now) {
+            // note : a late frame moves the schedule instead of making the next frames catch up
+            m_stats.missed++;
+            m_deadline = now;
+        } else {
+            waitDeadline(m_deadline);
+        }
+    }
+
+    const auto now = clock::now();
+    // note : unlimited, the schedule starts again from the end of this frame when a limit is set
+    if (fps <= 0.0) { m_deadline = now; }
+    record(now - m_last);
+    m_last = now;
+}
+
+auto engine::core::FramePacer::waitGpu() -> void
+{
+    // note : the slot holds the fence of the frame issued frames in flight ago
+    auto &fence = m_fences[m_frame % m_frames_in_flight];
+    m_frame++;
+
+    m_stats.fence_wait = {};
+    if (fence) {
+        if (::glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) {
+            constexpr GLuint64 TIMEOUT_NS{1'000'000};
+
+            const auto start = clock::now();
+            while (::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT_NS) == GL_TIMEOUT_EXPIRED) {}
+            m_stats.fence_wait = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+            m_stats.fence_stalls++;
+        }
+        ::glDeleteSync(fence);
+    }
+    fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+auto engine::core::FramePacer::waitDeadline(clock::time_point deadline) -> void
+{
+    constexpr auto ALPHA = 0.05;
+    constexpr auto SLEEP = std::chrono::milliseconds{1};
+
+    const auto start = clock::now();
+    for (;;) {
+        const auto left = std::chrono::duration<double, std::milli>{deadline - clock::now()};
+        if (left.count() <= m_sleep_mean + std::sqrt(m_sleep_variance)) { break; }
+
+        const auto before = clock::now();
+        std::this_thread::sleep_for(SLEEP);
+        const auto slept = std::chrono::duration<double, std::milli>{clock::now() - before};
+
+        const auto delta = slept.count() - m_sleep_mean;
+        m_sleep_mean += ALPHA * delta;
+        m_sleep_variance = (1.0 - ALPHA) * (m_sleep_variance + ALPHA * delta * delta);
+    }
+
+    const auto spin = clock::now();
+    while (clock::now() < deadline) { std::this_thread::yield(); }
+    const auto end = clock::now();
+
+    m_stats.slept = std::chrono::duration_cast<std::chrono::microseconds>(spin - start);
+    m_stats.spun = std::chrono::duration_cast<std::chrono::microseconds>(end - spin);
+}
+
+auto engine::core::FramePacer::record(clock::duration frame) -> void
+{
+    m_times[m_samples++ % HISTORY] = std::chrono::duration<float, std::milli>{frame}.count();
+
+    // note : the order of the frames does not matter here, the history is read from its start
+    const auto count = static_cast<double>(getCount());
+    const auto first = m_times.begin();
+    const auto last = first + static_cast<std::ptrdiff_t>(getCount());
+
+    const auto mean = std::accumulate(first, last, 0.0, [](double sum, float time) {
+        return sum + static_cast<double>(time);
+    }) / count;
+    const auto variance = std::accumulate(first, last, 0.0, [mean](double sum, float time) {
+        const auto delta = static_cast<double>(time) - mean;
+        return sum + delta * delta;
+    }) / count;
+    m_stats.jitter = std::sqrt(variance);
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <cstring>
+
+#include <spdlog/spdlog.h>
+
+#include "Engine/graphics/FrameReadback.hpp"
+
+namespace {
+
+constexpr auto CHANNEL = std::size_t{4};
+
+} // namespace
+
+engine::core::FrameReadback::FrameReadback()
+{
+    for (auto &slot : m_slots) { CALL_OPEN_GL(::glCreateBuffers(1, &slot.buffer)); }
+}
+
+engine::core::FrameReadback::~FrameReadback()
+{
+    for (auto &slot : m_slots) {
+        if (slot.fence != nullptr) { CALL_OPEN_GL(::glDeleteSync(slot.fence)); }
+        CALL_OPEN_GL(::glDeleteBuffers(1, &slot.buffer));
+    }
+}
+
+auto engine::core::FrameReadback::read(
+    int x, int y, int width, int height, std::string filename, ImageEncoder::Format format) -> bool
+{
+    const auto slot =
+        std::find_if(m_slots.begin(), m_slots.end(), [](const auto &s) { return s.fence == nullptr; });
+    if (slot == m_slots.end()) { return false; }
+
+    const auto size = static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * CHANNEL;
+    if (slot->capacity < size) {
+        // note : the storage is immutable, a bigger framebuffer needs a new buffer
+        CALL_OPEN_GL(::glDeleteBuffers(1, &slot->buffer));
+        CALL_OPEN_GL(::glCreateBuffers(1, &slot->buffer));
+        CALL_OPEN_GL(::glNamedBufferStorage(
+            slot->buffer, static_cast<GLsizeiptr>(size), nullptr, GL_MAP_READ_BIT | GL_CLIENT_STORAGE_BIT));
+        slot->capacity = size;
+    }
+
+    CALL_OPEN_GL(::glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer));
+    CALL_OPEN_GL(::glPixelStorei(GL_PACK_ALIGNMENT, 1));
+    CALL_OPEN_GL(::glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    CALL_OPEN_GL(::glBindBuffer(GL_PIXEL_PACK_BUFFER, 0));
+
+    slot->fence = ::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->sequence = m_sequence++;
+    slot->width = width;
+    slot->height = height;
+    slot->filename = std::move(filename);
+    slot->format = format;
+
+    return true;
+}
+
+auto engine::core::FrameReadback::poll(ImageEncoder &encoder) -> void { collect(encoder, 0); }
+
+auto engine::core::FrameReadback::reclaim(ImageEncoder &encoder) -> void
+{
+    collect(encoder, GL_TIMEOUT_IGNORED, 1);
+}
+
+auto engine::core::FrameReadback::flush(ImageEncoder &encoder) -> void
+{
+    collect(encoder, GL_TIMEOUT_IGNORED);
+}
+
+auto engine::core::FrameReadback::collect(ImageEncoder &encoder, GLuint64 timeout, std::size_t limit) -> void
+{
+    std::array<Slot *, SLOTS> pending{};
+    std::size_t count{0};
+    for (auto &slot : m_slots) {
+        if (slot.fence != nullptr) { pending[count++] = &slot; }
+    }
+    std::sort(pending.begin(), pending.begin() + static_cast<std::ptrdiff_t>(count), [](auto lhs, auto rhs) {
+        return lhs->sequence < rhs->sequence;
+    });
+
+    for (auto i = 0ul; i != std::min(count, limit); i++) {
+        const auto status = ::glClientWaitSync(pending[i]->fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED) {
+            resolve(*pending[i], encoder);
+        } else if (status == GL_WAIT_FAILED || timeout == GL_TIMEOUT_IGNORED) {
+            // note : the copy never completes, e.g. no context is current anymore, the slot is freed
+            drop(*pending[i], "the fence cannot be waited for");
+        } else {
+            // note : stop at the first copy not ready, the images are handed in the order they were requested
+            return;
+        }
+    }
+}
+
+auto engine::core::FrameReadback::drop(Slot &slot, const std::string_view reason) -> void
+{
+    spdlog::error("Engine::FrameReadback '{}' is lost, {}", slot.filename, reason);
+    ::glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+    slot.filename.clear();
+    m_dropped++;
+}
+
+auto engine::core::FrameReadback::resolve(Slot &slot, ImageEncoder &encoder) -> void
+{
+    const auto row = static_cast<std::size_t>(slot.width) * CHANNEL;
+    const auto rows = static_cast<std::size_t>(slot.height);
+
+    const auto *source = static_cast<const char *>(
+        ::glMapNamedBufferRange(slot.buffer, 0, static_cast<GLsizeiptr>(row * rows), GL_MAP_READ_BIT));
+    if (source == nullptr) {
+        drop(slot, "the pixel buffer cannot be mapped");
+        return;
+    }
+
+    CALL_OPEN_GL(::glDeleteSync(slot.fence));
+    slot.fence = nullptr;
+
+    ImageEncoder::Image image{
+        std::move(slot.filename), slot.format, slot.width, slot.height, std::vector<char>(row * rows)};
+
+    // note : OpenGL returns the bottom row first
+    for (auto j = 0ul; j != rows; j++) {
+        std::memcpy(image.pixels.data() + j * row, source + (rows - j - 1) * row, row);
+    }
+
+    CALL_OPEN_GL(::glUnmapNamedBuffer(slot.buffer));
+
+    encoder.push(std::move(image));
+}
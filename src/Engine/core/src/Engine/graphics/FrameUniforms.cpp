@@ -0,0 +1,43 @@
+#include <cstddef>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/graphics/FrameUniforms.hpp"
+#include "Engine/Camera.hpp"
+
+static_assert(offsetof(engine::core::FrameUniforms::Block, view) == 0);
+static_assert(offsetof(engine::core::FrameUniforms::Block, projection) == 64);
+static_assert(offsetof(engine::core::FrameUniforms::Block, view_projection) == 128);
+static_assert(offsetof(engine::core::FrameUniforms::Block, camera_position) == 192);
+static_assert(offsetof(engine::core::FrameUniforms::Block, time) == 208);
+static_assert(sizeof(engine::core::FrameUniforms::Block) == 224);
+
+engine::core::FrameUniforms::FrameUniforms()
+{
+    CALL_OPEN_GL(::glCreateBuffers(1, &m_buffer));
+    api::debug_label(GL_BUFFER, m_buffer, "Frame uniforms");
+    CALL_OPEN_GL(::glNamedBufferStorage(m_buffer, sizeof(Block), nullptr, GL_DYNAMIC_STORAGE_BIT));
+    CALL_OPEN_GL(::glBindBufferBase(GL_UNIFORM_BUFFER, BINDING, m_buffer));
+}
+
+engine::core::FrameUniforms::~FrameUniforms() { CALL_OPEN_GL(::glDeleteBuffers(1, &m_buffer)); }
+
+auto engine::core::FrameUniforms::update(Camera &camera, float time) -> void
+{
+    const auto view_changed = camera.hasChanged<Camera::Matrix::VIEW>();
+    const auto projection_changed = camera.hasChanged<Camera::Matrix::PROJECTION>();
+
+    if (view_changed) {
+        m_block.view = camera.getView();
+        m_block.camera_position = glm::vec4{camera.getPosition(), 1.0f};
+        camera.setChangedFlag<Camera::Matrix::VIEW>(false);
+    }
+    if (projection_changed) {
+        m_block.projection = camera.getProjection();
+        camera.setChangedFlag<Camera::Matrix::PROJECTION>(false);
+    }
+    if (view_changed || projection_changed) { m_block.view_projection = m_block.projection * m_block.view; }
+    m_block.time = time;
+
+    CALL_OPEN_GL(::glNamedBufferSubData(m_buffer, 0, sizeof(Block), &m_block));
+}
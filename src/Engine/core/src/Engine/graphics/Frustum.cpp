@@ -0,0 +1,80 @@
+#include <cmath>
+
+#include "Engine/graphics/Frustum.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ENGINE_FRUSTUM_SSE
+#    include <emmintrin.h>
+#endif
+
+engine::core::Frustum::Frustum(const glm::mat4 &view_projection) noexcept
+{
+    const auto row = [&m = view_projection](glm::length_t i) {
+        return glm::vec4{m[0][i], m[1][i], m[2][i], m[3][i]};
+    };
+
+    // note : Gribb & Hartmann, the planes are not normalized as only the sign of the distance is used
+    const auto planes = std::to_array<glm::vec4>({
+        row(3) + row(0), // left
+        row(3) - row(0), // right
+        row(3) + row(1), // bottom
+        row(3) - row(1), // top
+        row(3) + row(2), // near
+        row(3) - row(2), // far
+    });
+
+    m_w.fill(1.0f);
+    for (auto i = 0ul; i != planes.size(); i++) {
+        m_x[i] = planes[i].x;
+        m_y[i] = planes[i].y;
+        m_z[i] = planes[i].z;
+        m_w[i] = planes[i].w;
+    }
+}
+
+auto engine::core::Frustum::classify(const glm::vec3 &min, const glm::vec3 &max) const noexcept -> Result
+{
+    const auto center = (max + min) * 0.5f;
+    const auto extent = (max - min) * 0.5f;
+
+    // note : s is the distance of the center to the plane, r the projection of the extent on the normal
+    bool intersect{false};
+
+#ifdef ENGINE_FRUSTUM_SSE
+    const auto cx = _mm_set1_ps(center.x);
+    const auto cy = _mm_set1_ps(center.y);
+    const auto cz = _mm_set1_ps(center.z);
+    const auto ex = _mm_set1_ps(extent.x);
+    const auto ey = _mm_set1_ps(extent.y);
+    const auto ez = _mm_set1_ps(extent.z);
+    const auto sign = _mm_set1_ps(-0.0f);
+    const auto zero = _mm_setzero_ps();
+
+    for (auto i = 0ul; i != PLANES; i += 4) {
+        const auto x = _mm_load_ps(m_x.data() + i);
+        const auto y = _mm_load_ps(m_y.data() + i);
+        const auto z = _mm_load_ps(m_z.data() + i);
+        const auto w = _mm_load_ps(m_w.data() + i);
+
+        const auto s = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(x, cx), _mm_mul_ps(y, cy)), _mm_add_ps(_mm_mul_ps(z, cz), w));
+        const auto r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(sign, x), ex), _mm_mul_ps(_mm_andnot_ps(sign, y), ey)),
+            _mm_mul_ps(_mm_andnot_ps(sign, z), ez));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(_mm_add_ps(s, r), zero)) != 0) { return Result::OUTSIDE; }
+        intersect |= _mm_movemask_ps(_mm_cmplt_ps(_mm_sub_ps(s, r), zero)) != 0;
+    }
+#else
+    for (auto i = 0ul; i != PLANES; i++) {
+        const auto s = m_x[i] * center.x + m_y[i] * center.y + m_z[i] * center.z + m_w[i];
+        const auto r =
+            std::abs(m_x[i]) * extent.x + std::abs(m_y[i]) * extent.y + std::abs(m_z[i]) * extent.z;
+
+        if (s + r < 0.0f) { return Result::OUTSIDE; }
+        intersect |= s - r < 0.0f;
+    }
+#endif
+
+    return intersect ? Result::INTERSECT : Result::INSIDE;
+}
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/graphics/GeometryArena.hpp"
+
+namespace {
+
+constexpr auto VERTEX_SIZE = engine::core::GeometryArena::LAYOUT.stride();
+constexpr auto INDEX_SIZE = sizeof(std::uint32_t);
+
+constexpr auto INITIAL_CAPACITY = std::size_t{64} * 1024;
+
+} // namespace
+
+auto engine::core::GeometryArena::Stream::allocate(std::size_t bytes) -> std::size_t
+{
+    const auto offset = size;
+    if (size + bytes > capacity) {
+        const auto new_capacity = std::max({capacity * 2, size + bytes, INITIAL_CAPACITY});
+
+        GLuint new_buffer{0};
+        CALL_OPEN_GL(::glCreateBuffers(1, &new_buffer));
+        CALL_OPEN_GL(::glNamedBufferStorage(
+            new_buffer, static_cast<GLsizeiptr>(new_capacity), nullptr, GL_DYNAMIC_STORAGE_BIT));
+        api::debug_label(GL_BUFFER, new_buffer, label);
+        if (size != 0) {
+            CALL_OPEN_GL(
+                ::glCopyNamedBufferSubData(buffer, new_buffer, 0, 0, static_cast<GLsizeiptr>(size)));
+        }
+        CALL_OPEN_GL(::glDeleteBuffers(1, &buffer));
+
+        buffer = new_buffer;
+        capacity = new_capacity;
+    }
+    size += bytes;
+    return offset;
+}
+
+engine::core::GeometryArena::GeometryArena()
+{
+    CALL_OPEN_GL(::glCreateVertexArrays(1, &m_vao));
+    api::debug_label(GL_VERTEX_ARRAY, m_vao, "GeometryArena");
+}
+
+engine::core::GeometryArena::~GeometryArena()
+{
+    for (const auto buffer : {m_vertices.buffer, m_indices.buffer}) {
+        CALL_OPEN_GL(::glDeleteBuffers(1, &buffer));
+    }
+    CALL_OPEN_GL(::glDeleteVertexArrays(1, &m_vao));
+}
+
+auto engine::core::GeometryArena::bind() -> void
+{
+    // note : the buffer is replaced when the stream grows, the format is set again with it
+    LAYOUT.setup(m_vao, m_vertices.buffer, BINDING);
+    CALL_OPEN_GL(::glVertexArrayElementBuffer(m_vao, m_indices.buffer));
+}
+
+auto engine::core::GeometryArena::import(const entt::registry &world, entt::entity entity) -> const Mesh *
+{
+    const auto &vao = world.get<api::VAO>(entity);
+    if (const auto it = m_meshes.find(vao.content_hash); it != m_meshes.end()) {
+        return it->second ? &*it->second : nullptr;
+    }
+
+    auto &mesh = m_meshes[vao.content_hash];
+
+    const auto source = world.try_get<api::Vertices>(entity);
+    if (!source) {
+        spdlog::warn("engine::core::GeometryArena: {} has no vertices", entity);
+        return nullptr;
+    }
+
+    const std::size_t vertices{source->count};
+    const auto vertex_offset = m_vertices.allocate(vertices * VERTEX_SIZE);
+    if (source->layout == LAYOUT) {
+        CALL_OPEN_GL(::glCopyNamedBufferSubData(
+            source->range.buffer,
+            m_vertices.buffer,
+            static_cast<GLintptr>(source->range.offset),
+            static_cast<GLintptr>(vertex_offset),
+            static_cast<GLsizeiptr>(vertices * VERTEX_SIZE)));
+    } else {
+        // note : converted on the cpu, the vertices are read back once per mesh
+        std::vector<float> positions;
+        std::vector<float> colors;
+        positions.reserve(vertices * 3);
+        colors.reserve(vertices * 4);
+        for (const auto &point : source->read(api::VAO::Attribute::POSITION)) {
+            positions.insert(positions.end(), {point.x, point.y, point.z});
+        }
+        for (const auto &color : source->read(api::VAO::Attribute::COLOR)) {
+            colors.insert(colors.end(), {color.r, color.g, color.b, color.a});
+        }
+        const auto data = LAYOUT.encode(vertices, {positions, colors, {}});
+        CALL_OPEN_GL(::glNamedBufferSubData(
+            m_vertices.buffer,
+            static_cast<GLintptr>(vertex_offset),
+            static_cast<GLsizeiptr>(data.size()),
+            data.data()));
+    }
+
+    // note : the meshes without EBO are drawn with the sequence of their vertices
+    std::size_t indices{0};
+    std::size_t index_offset{0};
+    if (const auto ebo = world.try_get<api::EBO>(entity); ebo) {
+        indices = ebo->range.size / INDEX_SIZE;
+        index_offset = m_indices.allocate(indices * INDEX_SIZE);
+        CALL_OPEN_GL(::glCopyNamedBufferSubData(
+            ebo->range.buffer,
+            m_indices.buffer,
+            static_cast<GLintptr>(ebo->range.offset),
+            static_cast<GLintptr>(index_offset),
+            static_cast<GLsizeiptr>(indices * INDEX_SIZE)));
+    } else {
+        std::vector<std::uint32_t> sequence(vertices);
+        std::iota(sequence.begin(), sequence.end(), 0u);
+        indices = vertices;
+        index_offset = m_indices.allocate(indices * INDEX_SIZE);
+        CALL_OPEN_GL(::glNamedBufferSubData(
+            m_indices.buffer,
+            static_cast<GLintptr>(index_offset),
+            static_cast<GLsizeiptr>(indices * INDEX_SIZE),
+            sequence.data()));
+    }
+
+    bind();
+
+    m_stats.meshes++;
+    m_stats.vertices += vertices;
+    m_stats.indices += indices;
+
+    mesh = Mesh{
+        static_cast<GLuint>(index_offset / INDEX_SIZE),
+        static_cast<GLuint>(indices),
+        static_cast<GLint>(vertex_offset / VERTEX_SIZE)};
+    return &*mesh;
+}
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <numeric>
+
+#include "Engine/graphics/GpuProfiler.hpp"
+
+engine::core::GpuProfiler::Scope::Scope(GpuProfiler &profiler, std::size_t section) :
+    m_profiler{profiler},
+    m_section{section},
+    m_group{profiler.m_sections[section].name},
+    m_begin{profiler.acquire()}
+{
+    CALL_OPEN_GL(::glQueryCounter(m_begin, GL_TIMESTAMP));
+    m_start = std::chrono::steady_clock::now();
+}
+
+engine::core::GpuProfiler::Scope::~Scope()
+{
+    const auto cpu = std::chrono::duration<float, std::milli>{std::chrono::steady_clock::now() - m_start};
+
+    const auto end = m_profiler.acquire();
+    CALL_OPEN_GL(::glQueryCounter(end, GL_TIMESTAMP));
+
+    m_profiler.m_frames[m_profiler.m_frame % LATENCY].push_back({m_section, m_begin, end, cpu.count()});
+}
+
+engine::core::GpuProfiler::GpuProfiler(const std::filesystem::path &csv)
+{
+    if (!csv.empty()) {
+        m_csv.open(csv);
+        m_csv << "frame,section,cpu_ms,gpu_ms\n";
+    }
+}
+
+engine::core::GpuProfiler::~GpuProfiler()
+{
+    for (const auto &records : m_frames) {
+        for (const auto &record : records) {
+            m_pool.push_back(record.begin);
+            m_pool.push_back(record.end);
+        }
+    }
+    CALL_OPEN_GL(::glDeleteQueries(static_cast<GLsizei>(m_pool.size()), m_pool.data()));
+}
+
+auto engine::core::GpuProfiler::beginFrame() -> void
+{
+    m_frame++;
+    resolve(m_frames[m_frame % LATENCY]);
+}
+
+auto engine::core::GpuProfiler::scope(std::string_view name) -> Scope
+{
+    const auto it = std::find_if(
+        m_sections.begin(), m_sections.end(), [&name](const auto &section) { return section.name == name; });
+    if (it != m_sections.end()) { return {*this, static_cast<std::size_t>(it - m_sections.begin())}; }
+
+    m_sections.push_back({std::string{name}, {}, {}, 0});
+    return {*this, m_sections.size() - 1};
+}
+
+auto engine::core::GpuProfiler::summarize(const std::array<float, HISTORY> &values, std::size_t count)
+    -> Summary
+{
+    if (count == 0) { return {}; }
+
+    std::array<float, HISTORY> sorted;
+    std::copy_n(values.begin(), count, sorted.begin());
+    const auto last = sorted.begin() + static_cast<std::ptrdiff_t>(count);
+    const auto p99 = sorted.begin() + static_cast<std::ptrdiff_t>((count - 1) * 99 / 100);
+    std::nth_element(sorted.begin(), p99, last);
+
+    return {
+        static_cast<double>(*std::min_element(sorted.begin(), last)),
+        std::accumulate(
+            sorted.begin(), last, 0.0, [](double sum, float value) { return sum + static_cast<double>(value); })
+            / static_cast<double>(count),
+        static_cast<double>(*p99)};
+}
+
+auto engine::core::GpuProfiler::acquire() -> GLuint
+{
+    if (m_pool.empty()) {
+        GLuint query{0};
+        CALL_OPEN_GL(::glCreateQueries(GL_TIMESTAMP, 1, &query));
+        return query;
+    }
+    const auto query = m_pool.back();
+    m_pool.pop_back();
+    return query;
+}
+
+auto engine::core::GpuProfiler::resolve(std::vector<Record> &records) -> void
+{
+    // note : the frame number of the records, m_frame has already been advanced
+    const auto frame = m_frame - LATENCY;
+
+    for (const auto &record : records) {
+        GLint available{GL_FALSE};
+        CALL_OPEN_GL(::glGetQueryObjectiv(record.end, GL_QUERY_RESULT_AVAILABLE, &available));
+
+        if (available == GL_FALSE) {
+            m_dropped++;
+        } else {
+            GLuint64 begin{0};
+            GLuint64 end{0};
+            CALL_OPEN_GL(::glGetQueryObjectui64v(record.begin, GL_QUERY_RESULT, &begin));
+            CALL_OPEN_GL(::glGetQueryObjectui64v(record.end, GL_QUERY_RESULT, &end));
+            const auto gpu = static_cast<float>(static_cast<double>(end - begin) / 1'000'000.0);
+
+            auto &section = m_sections[record.section];
+            const auto index = section.samples++ % HISTORY;
+            section.cpu[index] = record.cpu;
+            section.gpu[index] = gpu;
+
+            if (m_csv.is_open()) {
+                m_csv << frame << ',' << section.name << ',' << record.cpu << ',' << gpu << '\n';
+            }
+        }
+
+        // note : a query still in flight can be issued again, its previous result is discarded
+        m_pool.push_back(record.begin);
+        m_pool.push_back(record.end);
+    }
+    records.clear();
+}
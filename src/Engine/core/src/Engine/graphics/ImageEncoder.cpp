@@ -0,0 +1,191 @@
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+
+#include "Engine/graphics/ImageEncoder.hpp"
+
+namespace {
+
+// https://qoiformat.org/qoi-specification.pdf
+auto write_qoi(const engine::core::ImageEncoder::Image &image) -> bool
+{
+    constexpr unsigned char OP_INDEX{0x00};
+    constexpr unsigned char OP_DIFF{0x40};
+    constexpr unsigned char OP_LUMA{0x80};
+    constexpr unsigned char OP_RUN{0xc0};
+    constexpr unsigned char OP_RGB{0xfe};
+    constexpr unsigned char OP_RGBA{0xff};
+    constexpr auto MAX_RUN = 62;
+
+    struct Pixel {
+        unsigned char r, g, b, a;
+
+        auto operator==(const Pixel &) const -> bool = default;
+    };
+
+    const auto width = static_cast<std::uint32_t>(image.width);
+    const auto height = static_cast<std::uint32_t>(image.height);
+    const auto count = static_cast<std::size_t>(width) * height;
+
+    std::vector<unsigned char> out;
+    // note : worst case, every pixel is written as OP_RGBA
+    out.reserve(14 + count * 5 + 8);
+
+    const auto put = [&out](auto byte) { out.push_back(static_cast<unsigned char>(byte)); };
+    const auto put32 = [&put](std::uint32_t value) {
+        for (auto shift = 24; shift >= 0; shift -= 8) { put((value >> shift) & 0xffu); }
+    };
+
+    for (const auto c : {'q', 'o', 'i', 'f'}) { put(c); }
+    put32(width);
+    put32(height);
+    put(4);
+    put(0);
+
+    std::array<Pixel, 64> index{};
+    Pixel previous{0, 0, 0, 255};
+    auto run = 0;
+
+    const auto *pixels = reinterpret_cast<const unsigned char *>(image.pixels.data());
+    for (std::size_t i = 0; i != count; i++) {
+        const Pixel pixel{pixels[i * 4], pixels[i * 4 + 1], pixels[i * 4 + 2], pixels[i * 4 + 3]};
+
+        if (pixel == previous) {
+            if (++run == MAX_RUN || i + 1 == count) {
+                put(OP_RUN | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0) {
+            put(OP_RUN | (run - 1));
+            run = 0;
+        }
+
+        const auto hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+        auto &slot = index[static_cast<std::size_t>(hash)];
+
+        if (slot == pixel) {
+            put(OP_INDEX | hash);
+        } else if (slot = pixel; pixel.a == previous.a) {
+            const auto dr = static_cast<signed char>(pixel.r - previous.r);
+            const auto dg = static_cast<signed char>(pixel.g - previous.g);
+            const auto db = static_cast<signed char>(pixel.b - previous.b);
+            const auto dr_dg = dr - dg;
+            const auto db_dg = db - dg;
+
+            if (dr > -3 && dr < 2 && dg > -3 && dg < 2 && db > -3 && db < 2) {
+                put(OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+            } else if (dr_dg > -9 && dr_dg < 8 && dg > -33 && dg < 32 && db_dg > -9 && db_dg < 8) {
+                put(OP_LUMA | (dg + 32));
+                put((dr_dg + 8) << 4 | (db_dg + 8));
+            } else {
+                for (const auto c : {OP_RGB, pixel.r, pixel.g, pixel.b}) { put(c); }
+            }
+        } else {
+            for (const auto c : {OP_RGBA, pixel.r, pixel.g, pixel.b, pixel.a}) { put(c); }
+        }
+
+        previous = pixel;
+    }
+
+    for (const auto c : {0, 0, 0, 0, 0, 0, 0, 1}) { put(c); }
+
+    std::ofstream file{image.filename, std::ios::binary};
+    file.write(reinterpret_cast<const char *>(out.data()), static_cast<std::streamsize>(out.size()));
+    return file.good();
+}
+
+auto write_raw(const engine::core::ImageEncoder::Image &image) -> bool
+{
+    std::ofstream file{image.filename, std::ios::binary};
+    file.write(image.pixels.data(), static_cast<std::streamsize>(image.pixels.size()));
+    return file.good();
+}
+
+} // namespace
+
+engine::core::ImageEncoder::ImageEncoder(std::size_t workers, std::size_t capacity) :
+    m_capacity{std::max(capacity, std::size_t{1})}
+{
+    if (workers == 0) { workers = std::max(std::thread::hardware_concurrency() / 2u, 1u); }
+
+    m_workers.reserve(workers);
+    for (auto i = 0ul; i != workers; i++) { m_workers.emplace_back(&ImageEncoder::run, this); }
+}
+
+engine::core::ImageEncoder::~ImageEncoder()
+{
+    {
+        std::scoped_lock lock{m_mutex};
+        m_stop = true;
+    }
+    m_not_empty.notify_all();
+    for (auto &worker : m_workers) { worker.join(); }
+}
+
+auto engine::core::ImageEncoder::push(Image &&image) -> void
+{
+    {
+        std::unique_lock lock{m_mutex};
+        if (m_queue.size() >= m_capacity) {
+            const auto start = std::chrono::steady_clock::now();
+            m_not_full.wait(lock, [this] { return m_queue.size() < m_capacity; });
+            m_stats.stalls++;
+            m_stats.stalled += std::chrono::steady_clock::now() - start;
+        }
+        m_queue.push_back(std::move(image));
+        m_stats.peak = std::max(m_stats.peak, m_queue.size());
+    }
+    m_not_empty.notify_one();
+}
+
+auto engine::core::ImageEncoder::getPending() const -> std::size_t
+{
+    std::scoped_lock lock{m_mutex};
+    return m_queue.size();
+}
+
+auto engine::core::ImageEncoder::getStats() const -> Stats
+{
+    std::scoped_lock lock{m_mutex};
+    return m_stats;
+}
+
+auto engine::core::ImageEncoder::run() -> void
+{
+    for (;;) {
+        Image image;
+        {
+            std::unique_lock lock{m_mutex};
+            m_not_empty.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+            if (m_queue.empty()) { return; }
+            image = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+        m_not_full.notify_one();
+
+        const auto success = encode(image);
+        if (!success) { spdlog::warn("failed to write the image: {}", image.filename); }
+
+        std::scoped_lock lock{m_mutex};
+        (success ? m_stats.encoded : m_stats.failed)++;
+    }
+}
+
+auto engine::core::ImageEncoder::encode(const Image &image) -> bool
+{
+    switch (image.format) {
+    case Format::PNG:
+        return !!::stbi_write_png(image.filename.data(), image.width, image.height, 4, image.pixels.data(), 0);
+    case Format::QOI: return write_qoi(image);
+    case Format::RAW: return write_raw(image);
+    }
+    return false;
+}
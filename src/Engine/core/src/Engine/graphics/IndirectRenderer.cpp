@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <numeric>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/graphics/IndirectRenderer.hpp"
+
+namespace {
+
+constexpr auto VERT_SH = R"(#version 450
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec4 inColors;
+layout (location = 3) in uint inDraw;
+
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    vec4 camera_position;
+    float time;
+};
+
+layout (std430, binding = 0) readonly buffer Transforms {
+    mat4 transforms[];
+};
+
+struct DrawData {
+    vec4 tint;
+    uint transform;
+};
+
+layout (std430, binding = 1) readonly buffer Draws {
+    DrawData draws[];
+};
+
+out vec4 fragColors;
+
+void main()
+{
+    const DrawData draw = draws[inDraw];
+
+    gl_Position = view_projection * transforms[draw.transform] * vec4(inPos, 1.0f);
+
+    fragColors = inColors * draw.tint;
+}
+)";
+
+constexpr auto FRAG_SH = R"(#version 450
+in vec4 fragColors;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = fragColors;
+}
+)";
+
+} // namespace
+
+engine::core::IndirectRenderer::IndirectRenderer() : m_shader{VERT_SH, FRAG_SH}
+{
+    CALL_OPEN_GL(::glCreateBuffers(1, &m_command_buffer));
+    CALL_OPEN_GL(::glCreateBuffers(1, &m_draw_buffer));
+    CALL_OPEN_GL(::glCreateBuffers(1, &m_sequence_buffer));
+    api::debug_label(GL_BUFFER, m_command_buffer, "IndirectRenderer commands");
+    api::debug_label(GL_BUFFER, m_draw_buffer, "IndirectRenderer draws");
+    api::debug_label(GL_BUFFER, m_sequence_buffer, "IndirectRenderer sequence");
+
+    const auto vao = m_arena.getVAO();
+    CALL_OPEN_GL(::glEnableVertexArrayAttrib(vao, ATTRIBUTE_DRAW));
+    CALL_OPEN_GL(::glVertexArrayAttribIFormat(vao, ATTRIBUTE_DRAW, 1, GL_UNSIGNED_INT, 0));
+    CALL_OPEN_GL(::glVertexArrayAttribBinding(vao, ATTRIBUTE_DRAW, BINDING_DRAW));
+    CALL_OPEN_GL(::glVertexArrayBindingDivisor(vao, BINDING_DRAW, 1));
+}
+
+engine::core::IndirectRenderer::~IndirectRenderer()
+{
+    for (const auto buffer : {m_command_buffer, m_draw_buffer, m_sequence_buffer}) {
+        CALL_OPEN_GL(::glDeleteBuffers(1, &buffer));
+    }
+}
+
+auto engine::core::IndirectRenderer::draw(
+    entt::registry &world,
+    const TransformSystem &transforms,
+    const CullingSystem &culling,
+    StateTracker &state) -> void
+{
+    static constexpr auto NO_TINT = glm::vec4{1.0f, 1.0f, 1.0f, 1.0f};
+
+    m_stats = {};
+    m_entries.clear();
+
+    world.view<api::VAO, api::Transform>(entt::exclude<StaticBatcher::Member>).each(
+        [this, &world, &culling](const auto entity, const api::VAO &vao, const api::Transform &transform) {
+            if (!culling.isVisible(entity)) { return; }
+
+            const auto mesh = m_arena.import(world, entity);
+            if (!mesh) {
+                m_stats.rejected++;
+                return;
+            }
+
+            const auto tint = world.try_get<api::Tint4f>(entity);
+            m_entries.push_back({vao.mode, mesh, {tint ? tint->vec : NO_TINT, transform.slot, {}}});
+        });
+
+    if (m_entries.empty()) { return; }
+
+    // note : the entries are grouped by mode then by mesh, each group of a mesh become one command
+    std::sort(m_entries.begin(), m_entries.end(), [](const auto &a, const auto &b) {
+        return a.mode != b.mode ? a.mode < b.mode : a.mesh < b.mesh;
+    });
+
+    m_commands.clear();
+    m_draws.clear();
+    m_ranges.clear();
+    const Entry *previous{nullptr};
+    for (const auto &entry : m_entries) {
+        const auto base_instance = static_cast<GLuint>(m_draws.size());
+        m_draws.push_back(entry.data);
+
+        if (previous && previous->mode == entry.mode && previous->mesh == entry.mesh) {
+            m_commands.back().instance_count++;
+        } else {
+            if (!previous || previous->mode != entry.mode) {
+                m_ranges.push_back({entry.mode, m_commands.size(), 0});
+            }
+            const auto &mesh = *entry.mesh;
+            m_commands.push_back({mesh.index_count, 1u, mesh.first_index, mesh.base_vertex, base_instance});
+            m_ranges.back().count++;
+        }
+        previous = &entry;
+    }
+
+    if (m_draws.size() > m_sequence_size) {
+        m_sequence_size = std::max(m_draws.size(), m_sequence_size * 2);
+        std::vector<std::uint32_t> sequence(m_sequence_size);
+        std::iota(sequence.begin(), sequence.end(), 0u);
+        CALL_OPEN_GL(::glNamedBufferData(
+            m_sequence_buffer,
+            static_cast<GLsizeiptr>(sequence.size() * sizeof(std::uint32_t)),
+            sequence.data(),
+            GL_STATIC_DRAW));
+        CALL_OPEN_GL(::glVertexArrayVertexBuffer(
+            m_arena.getVAO(),
+            BINDING_DRAW,
+            m_sequence_buffer,
+            0,
+            static_cast<GLsizei>(sizeof(std::uint32_t))));
+    }
+
+    CALL_OPEN_GL(::glNamedBufferData(
+        m_draw_buffer,
+        static_cast<GLsizeiptr>(m_draws.size() * sizeof(DrawData)),
+        m_draws.data(),
+        GL_STREAM_DRAW));
+    CALL_OPEN_GL(::glNamedBufferData(
+        m_command_buffer,
+        static_cast<GLsizeiptr>(m_commands.size() * sizeof(Command)),
+        m_commands.data(),
+        GL_STREAM_DRAW));
+
+    m_shader.use(state);
+    CALL_OPEN_GL(
+        ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TransformSystem::BINDING, transforms.getBuffer()));
+    CALL_OPEN_GL(::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, DRAW_DATA_BINDING, m_draw_buffer));
+    state.bindBuffer(GL_DRAW_INDIRECT_BUFFER, m_command_buffer);
+    state.bindVertexArray(m_arena.getVAO());
+
+    for (const auto &range : m_ranges) {
+        state.multiDrawElementsIndirect(
+            static_cast<GLenum>(range.mode),
+            range.first * sizeof(Command),
+            range.count,
+            static_cast<GLsizei>(sizeof(Command)));
+    }
+
+    m_stats.multi_draws = m_ranges.size();
+    m_stats.commands = m_commands.size();
+    m_stats.draws = m_draws.size();
+}
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <cstddef>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/graphics/InstancedRenderer.hpp"
+
+namespace {
+
+constexpr auto VERT_SH = R"(#version 450
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec4 inColors;
+layout (location = 3) in uint inTransform;
+layout (location = 4) in vec4 inTint;
+
+layout (std430, binding = 0) readonly buffer Transforms {
+    mat4 transforms[];
+};
+
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    vec4 camera_position;
+    float time;
+};
+
+out vec4 fragColors;
+
+void main()
+{
+    gl_Position = view_projection * transforms[inTransform] * vec4(inPos, 1.0f);
+
+    fragColors = inColors * inTint;
+}
+)";
+
+constexpr auto FRAG_SH = R"(#version 450
+in vec4 fragColors;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = fragColors;
+}
+)";
+
+} // namespace
+
+engine::core::InstancedRenderer::InstancedRenderer(entt::registry &world) :
+    m_world{world}, m_shader{VERT_SH, FRAG_SH}
+{
+    CALL_OPEN_GL(::glCreateBuffers(1, &m_instance_buffer));
+    api::debug_label(GL_BUFFER, m_instance_buffer, "InstancedRenderer instances");
+    m_world.on_destroy<api::VAO>().connect<&InstancedRenderer::on_destroy_vao>(*this);
+}
+
+engine::core::InstancedRenderer::~InstancedRenderer()
+{
+    m_world.on_destroy<api::VAO>().disconnect<&InstancedRenderer::on_destroy_vao>(*this);
+    CALL_OPEN_GL(::glDeleteBuffers(1, &m_instance_buffer));
+}
+
+auto engine::core::InstancedRenderer::on_destroy_vao(entt::registry &world, entt::entity entity) -> void
+{
+    m_configured.erase(world.get<api::VAO>(entity).object);
+}
+
+auto engine::core::InstancedRenderer::draw(
+    entt::registry &world,
+    const TransformSystem &transforms,
+    const CullingSystem &culling,
+    api::RingBuffer &ring,
+    StateTracker &state) -> void
+{
+    static constexpr auto NO_TINT = glm::vec4{1.0f, 1.0f, 1.0f, 1.0f};
+
+    for (auto &batch : m_batches) { batch.instances.clear(); }
+
+    const auto gather = [this, &world, &culling](
+                            const auto entity, const api::VAO &vao, const api::Transform &transform) {
+        if (!culling.isVisible(entity)) { return; }
+
+        const auto tint = world.try_get<api::Tint4f>(entity);
+
+        const auto level = LODSystem::select(vao, world.try_get<api::LOD>(entity));
+        const Key key{vao.content_hash, vao.mode, level.first, level.count, world.has<api::EBO>(entity)};
+        const auto [it, inserted] = m_batch_index.try_emplace(key, m_batches.size());
+        if (inserted) { m_batches.push_back({key, vao.object, {}}); }
+
+        auto &batch = m_batches[it->second];
+        // note : any VAO of the group can be used to draw, pick one alive this frame
+        if (batch.instances.empty()) { batch.vao = vao.object; }
+        batch.instances.push_back({tint ? tint->vec : NO_TINT, transform.slot});
+    };
+    world.view<api::VAO, api::Transform>(entt::exclude<StaticBatcher::Member>).each(gather);
+
+    if (std::erase_if(m_batches, [](const auto &batch) { return batch.instances.empty(); }) != 0) {
+        m_batch_index.clear();
+        for (auto i = 0ul; i != m_batches.size(); i++) { m_batch_index.emplace(m_batches[i].key, i); }
+    }
+
+    std::size_t count{0};
+    for (const auto &batch : m_batches) { count += batch.instances.size(); }
+
+    m_stats = {m_batches.size(), count};
+    if (count == 0) { return; }
+
+    // note : the instances are written in the ring buffer, the orphaned buffer is only used when it is full
+    GLuint buffer{m_instance_buffer};
+    GLintptr offset{0};
+    if (const auto allocation = ring.allocate(count * sizeof(Instance)); allocation) {
+        auto *destination = static_cast<Instance *>(allocation.data);
+        for (const auto &batch : m_batches) {
+            destination = std::copy(batch.instances.begin(), batch.instances.end(), destination);
+        }
+        buffer = allocation.buffer;
+        offset = static_cast<GLintptr>(allocation.offset);
+    } else {
+        m_upload.clear();
+        for (const auto &batch : m_batches) {
+            m_upload.insert(m_upload.end(), batch.instances.begin(), batch.instances.end());
+        }
+        CALL_OPEN_GL(::glNamedBufferData(
+            m_instance_buffer,
+            static_cast<GLsizeiptr>(m_upload.size() * sizeof(Instance)),
+            m_upload.data(),
+            GL_STREAM_DRAW));
+    }
+
+    m_shader.use(state);
+    CALL_OPEN_GL(
+        ::glBindBufferBase(GL_SHADER_STORAGE_BUFFER, TransformSystem::BINDING, transforms.getBuffer()));
+
+    for (const auto &batch : m_batches) {
+        if (const auto [_, inserted] = m_configured.insert(batch.vao); inserted) {
+            CALL_OPEN_GL(::glEnableVertexArrayAttrib(batch.vao, ATTRIBUTE_TRANSFORM));
+            CALL_OPEN_GL(::glVertexArrayAttribIFormat(
+                batch.vao,
+                ATTRIBUTE_TRANSFORM,
+                1,
+                GL_UNSIGNED_INT,
+                static_cast<GLuint>(offsetof(Instance, transform))));
+            CALL_OPEN_GL(::glVertexArrayAttribBinding(batch.vao, ATTRIBUTE_TRANSFORM, INSTANCE_BINDING));
+            CALL_OPEN_GL(::glEnableVertexArrayAttrib(batch.vao, ATTRIBUTE_TINT));
+            CALL_OPEN_GL(::glVertexArrayAttribFormat(
+                batch.vao,
+                ATTRIBUTE_TINT,
+                4,
+                GL_FLOAT,
+                GL_FALSE,
+                static_cast<GLuint>(offsetof(Instance, tint))));
+            CALL_OPEN_GL(::glVertexArrayAttribBinding(batch.vao, ATTRIBUTE_TINT, INSTANCE_BINDING));
+            CALL_OPEN_GL(::glVertexArrayBindingDivisor(batch.vao, INSTANCE_BINDING, 1));
+        }
+
+        CALL_OPEN_GL(::glVertexArrayVertexBuffer(
+            batch.vao, INSTANCE_BINDING, buffer, offset, static_cast<GLsizei>(sizeof(Instance))));
+        state.bindVertexArray(batch.vao);
+
+        const auto mode = static_cast<GLenum>(batch.key.mode);
+        const auto instances = static_cast<GLsizei>(batch.instances.size());
+        if (batch.key.has_ebo) {
+            state.drawElements(mode, batch.key.count, static_cast<std::size_t>(batch.key.first), instances);
+        } else {
+            state.drawArrays(mode, batch.key.first, batch.key.count, instances);
+        }
+
+        offset += static_cast<GLintptr>(batch.instances.size() * sizeof(Instance));
+    }
+}
@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Engine/graphics/OcclusionBuffer.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define ENGINE_OCCLUSION_SSE
+#    include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr auto FAR = 1.0f;
+
+// coordinates of the pixel containing value, clamped to [0, size]
+auto to_pixel(float value, std::size_t size) noexcept
+{
+    return static_cast<std::int32_t>(std::clamp(value, 0.0f, static_cast<float>(size)));
+}
+
+// coefficients of the edge function a * x + b * y + c, positive on the left of the edge from -> to
+struct Edge {
+    float a;
+    float b;
+    float c;
+
+    Edge(const glm::vec3 &from, const glm::vec3 &to) noexcept :
+        a{from.y - to.y}, b{to.x - from.x}, c{from.x * to.y - from.y * to.x}
+    {
+    }
+};
+
+} // namespace
+
+engine::core::OcclusionBuffer::OcclusionBuffer()
+{
+    for (std::size_t level = 0; level != LEVELS; level++) {
+        m_levels[level].assign((WIDTH >> level) * (HEIGHT >> level), FAR);
+    }
+}
+
+auto engine::core::OcclusionBuffer::begin(const glm::mat4 &view_projection) -> void
+{
+    m_view_projection = view_projection;
+    m_triangles.clear();
+}
+
+auto engine::core::OcclusionBuffer::addMesh(
+    const glm::mat4 &model, std::span<const glm::vec3> positions, std::span<const std::uint32_t> indices)
+    -> void
+{
+    const auto model_view_projection = m_view_projection * model;
+
+    const auto to_screen = [](const glm::vec4 &clip) {
+        const auto ndc = glm::vec3{clip} / clip.w;
+        return glm::vec3{
+            (ndc.x * 0.5f + 0.5f) * static_cast<float>(WIDTH),
+            (ndc.y * 0.5f + 0.5f) * static_cast<float>(HEIGHT),
+            ndc.z * 0.5f + 0.5f};
+    };
+
+    std::array<glm::vec4, 3> triangle;
+    std::array<glm::vec3, 4> polygon;
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        if (std::max({indices[i], indices[i + 1], indices[i + 2]}) >= positions.size()) { continue; }
+
+        for (std::size_t j = 0; j != 3; j++) {
+            triangle[j] = model_view_projection * glm::vec4{positions[indices[i + j]], 1.0f};
+        }
+
+        // note : clipped against the near plane only, z + w being the distance to it in clip space
+        std::size_t count{0};
+        for (std::size_t j = 0; j != 3; j++) {
+            const auto &current = triangle[j];
+            const auto &next = triangle[(j + 1) % 3];
+            const auto current_distance = current.z + current.w;
+            const auto next_distance = next.z + next.w;
+            if (current_distance >= 0.0f) { polygon[count++] = to_screen(current); }
+            if ((current_distance >= 0.0f) != (next_distance >= 0.0f)) {
+                const auto t = current_distance / (current_distance - next_distance);
+                polygon[count++] = to_screen(current + (next - current) * t);
+            }
+        }
+
+        if (count >= 3) { addTriangle(polygon[0], polygon[1], polygon[2]); }
+        if (count == 4) { addTriangle(polygon[0], polygon[2], polygon[3]); }
+    }
+}
+
+auto engine::core::OcclusionBuffer::addTriangle(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c)
+    -> void
+{
+    const auto area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+    if (!std::isfinite(area) || area == 0.0f) { return; }
+
+    // note : both faces are rasterized, the triangles are stored counter clockwise
+    Triangle triangle{area > 0.0f ? std::to_array({a, b, c}) : std::to_array({a, c, b}), 0, 0, 0, 0};
+
+    const auto min = glm::min(a, glm::min(b, c));
+    const auto max = glm::max(a, glm::max(b, c));
+    triangle.min_x = to_pixel(std::floor(min.x), WIDTH);
+    triangle.max_x = to_pixel(std::ceil(max.x), WIDTH);
+    triangle.min_y = to_pixel(std::floor(min.y), HEIGHT);
+    triangle.max_y = to_pixel(std::ceil(max.y), HEIGHT);
+    if (triangle.min_x == triangle.max_x || triangle.min_y == triangle.max_y || min.z > FAR) { return; }
+
+    m_triangles.push_back(triangle);
+}
+
+auto engine::core::OcclusionBuffer::rasterize(std::size_t band) -> void
+{
+    const auto first_row = band * BAND_HEIGHT;
+    const auto last_row = first_row + BAND_HEIGHT;
+
+    std::fill_n(m_levels[0].data() + first_row * WIDTH, BAND_HEIGHT * WIDTH, FAR);
+
+    for (const auto &triangle : m_triangles) {
+        const auto first = std::max(static_cast<std::int32_t>(first_row), triangle.min_y);
+        const auto last = std::min(static_cast<std::int32_t>(last_row), triangle.max_y);
+        if (first < last) { rasterize(triangle, first, last); }
+    }
+
+    for (std::size_t level = 1; level != LEVELS; level++) {
+        const auto width = WIDTH >> level;
+        const auto &below = m_levels[level - 1];
+        auto &current = m_levels[level];
+        for (auto y = first_row >> level; y != last_row >> level; y++) {
+            for (std::size_t x = 0; x != width; x++) {
+                const auto i = y * 2 * width * 2 + x * 2;
+                const auto j = i + width * 2;
+                current[y * width + x] = std::max({below[i], below[i + 1], below[j], below[j + 1]});
+            }
+        }
+    }
+}
+
+auto engine::core::OcclusionBuffer::rasterize(
+    const Triangle &triangle, std::int32_t first_row, std::int32_t last_row) noexcept -> void
+{
+    const auto &[v0, v1, v2] = triangle.vertices;
+
+    // note : the edge i is opposite to the vertex i, its function divided by the area is the barycentric i
+    const auto e0 = Edge{v1, v2};
+    const auto e1 = Edge{v2, v0};
+    const auto e2 = Edge{v0, v1};
+    const auto area = e0.a * v0.x + e0.b * v0.y + e0.c;
+
+    // depth as a plane a * x + b * y + c
+    const auto za = (e0.a * v0.z + e1.a * v1.z + e2.a * v2.z) / area;
+    const auto zb = (e0.b * v0.z + e1.b * v1.z + e2.b * v2.z) / area;
+    const auto zc = (e0.c * v0.z + e1.c * v1.z + e2.c * v2.z) / area;
+
+#ifdef ENGINE_OCCLUSION_SSE
+    // note : the pixels are processed 4 by 4 from an aligned column, WIDTH is a multiple of 4
+    const auto first_column = triangle.min_x & ~std::int32_t{3};
+    const auto offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+    const auto zero = _mm_setzero_ps();
+    const auto a0 = _mm_set1_ps(e0.a);
+    const auto a1 = _mm_set1_ps(e1.a);
+    const auto a2 = _mm_set1_ps(e2.a);
+    const auto az = _mm_set1_ps(za);
+#endif
+
+    for (auto y = first_row; y != last_row; y++) {
+        const auto py = static_cast<float>(y) + 0.5f;
+        auto *row = m_levels[0].data() + static_cast<std::size_t>(y) * WIDTH;
+
+#ifdef ENGINE_OCCLUSION_SSE
+        const auto r0 = _mm_set1_ps(e0.b * py + e0.c);
+        const auto r1 = _mm_set1_ps(e1.b * py + e1.c);
+        const auto r2 = _mm_set1_ps(e2.b * py + e2.c);
+        const auto rz = _mm_set1_ps(zb * py + zc);
+
+        for (auto x = first_column; x < triangle.max_x; x += 4) {
+            const auto px = _mm_add_ps(_mm_set1_ps(static_cast<float>(x)), offsets);
+            const auto inside = _mm_and_ps(
+                _mm_and_ps(
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a0, px), r0), zero),
+                    _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a1, px), r1), zero)),
+                _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(a2, px), r2), zero));
+            if (_mm_movemask_ps(inside) == 0) { continue; }
+
+            const auto depth = _mm_add_ps(_mm_mul_ps(az, px), rz);
+            const auto previous = _mm_loadu_ps(row + x);
+            _mm_storeu_ps(
+                row + x,
+                _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(previous, depth)), _mm_andnot_ps(inside, previous)));
+        }
+#else
+        for (auto x = triangle.min_x; x != triangle.max_x; x++) {
+            const auto px = static_cast<float>(x) + 0.5f;
+            if (e0.a * px + e0.b * py + e0.c < 0.0f || e1.a * px + e1.b * py + e1.c < 0.0f
+                || e2.a * px + e2.b * py + e2.c < 0.0f) {
+                continue;
+            }
+            row[x] = std::min(row[x], za * px + zb * py + zc);
+        }
+#endif
+    }
+}
+
+auto engine::core::OcclusionBuffer::isVisible(
+    const glm::vec3 &min, const glm::vec3 &max, const glm::mat4 &model) const noexcept -> bool
+{
+    const auto model_view_projection = m_view_projection * model;
+
+    auto lower = glm::vec3{std::numeric_limits<float>::max()};
+    auto upper = glm::vec3{-std::numeric_limits<float>::max()};
+    for (auto i = 0u; i != 8u; i++) {
+        const auto corner = glm::vec4{
+            (i & 1u) != 0u ? max.x : min.x,
+            (i & 2u) != 0u ? max.y : min.y,
+            (i & 4u) != 0u ? max.z : min.z,
+            1.0f};
+        const auto clip = model_view_projection * corner;
+
+        // note : a box crossing the near plane may cover the whole screen, it is never hidden
+        if (clip.w <= 0.0f || clip.z + clip.w < 0.0f) { return true; }
+
+        const auto ndc = glm::vec3{clip} / clip.w;
+        lower = glm::min(lower, ndc);
+        upper = glm::max(upper, ndc);
+    }
+
+    // note : the boxes out of the screen are left to the frustum culling
+    if (upper.x < -1.0f || lower.x > 1.0f || upper.y < -1.0f || lower.y > 1.0f) { return true; }
+
+    const auto nearest = lower.z * 0.5f + 0.5f;
+    const auto first_x = to_pixel((lower.x * 0.5f + 0.5f) * static_cast<float>(WIDTH), WIDTH - 1);
+    const auto last_x = to_pixel((upper.x * 0.5f + 0.5f) * static_cast<float>(WIDTH), WIDTH - 1);
+    const auto first_y = to_pixel((lower.y * 0.5f + 0.5f) * static_cast<float>(HEIGHT), HEIGHT - 1);
+    const auto last_y = to_pixel((upper.y * 0.5f + 0.5f) * static_cast<float>(HEIGHT), HEIGHT - 1);
+
+    // note : the level where the box covers about 2x2 texels, the coarsest one may have a few more
+    const auto size = std::max(last_x - first_x, last_y - first_y) + 1;
+    std::size_t level{0};
+    while (level + 1 != LEVELS && (size >> level) > 2) { level++; }
+
+    const auto &depth = m_levels[level];
+    const auto width = WIDTH >> level;
+    const auto shift = static_cast<std::int32_t>(level);
+    for (auto y = first_y >> shift; y <= last_y >> shift; y++) {
+        for (auto x = first_x >> shift; x <= last_x >> shift; x++) {
+            if (depth[static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)] >= nearest) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
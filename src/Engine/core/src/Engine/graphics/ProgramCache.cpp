@@ -0,0 +1,181 @@
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <vector>
+
+#if defined(_WIN32)
+#    include <process.h>
+#else
+#    include <unistd.h>
+#endif
+
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <Engine/helpers/hash.hpp>
+
+#include "Engine/graphics/ProgramCache.hpp"
+
+namespace {
+
+template<typename Duration>
+auto to_ms(Duration duration)
+{
+    return std::chrono::duration<double, std::milli>{duration}.count();
+}
+
+auto process_id()
+{
+#if defined(_WIN32)
+    return ::_getpid();
+#else
+    return ::getpid();
+#endif
+}
+
+} // namespace
+
+auto engine::core::ProgramCache::key(std::initializer_list<std::string_view> sources) -> std::uint64_t
+{
+    if (!m_driver.has_value()) {
+        auto hash = api::HASH_SEED;
+        constexpr auto NAMES =
+            std::to_array<GLenum>({GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION});
+        for (const auto name : NAMES) {
+            const std::string_view value{reinterpret_cast<const char *>(::glGetString(name))};
+            hash = api::hash_bytes(value.data(), value.size(), hash);
+        }
+        m_driver = hash;
+    }
+
+    auto hash = *m_driver;
+    for (const auto source : sources) {
+        // note : the size is hashed too so the boundaries between the sources matter
+        const auto size = source.size();
+        hash = api::hash_bytes(&size, sizeof(size), hash);
+        hash = api::hash_bytes(source.data(), source.size(), hash);
+    }
+    return hash;
+}
+
+auto engine::core::ProgramCache::isEnabled() -> bool
+{
+    if (m_directory.empty()) { return false; }
+
+    if (!m_formats.has_value()) {
+        GLint count{0};
+        CALL_OPEN_GL(::glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count));
+        m_formats.emplace(static_cast<std::size_t>(std::max(count, 0)));
+        if (count > 0) { CALL_OPEN_GL(::glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, m_formats->data())); }
+        if (m_formats->empty()) {
+            spdlog::warn("Engine::Core [ProgramCache] no program binary format available");
+        }
+    }
+    return !m_formats->empty();
+}
+
+auto engine::core::ProgramCache::path(std::uint64_t key) const -> std::filesystem::path
+{
+    return m_directory / fmt::format("{:016x}.bin", key);
+}
+
+auto engine::core::ProgramCache::load(GLuint program, std::uint64_t key) -> bool
+{
+    if (!isEnabled()) { return false; }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    std::ifstream file{path(key), std::ios::binary};
+    if (!file) {
+        m_stats.misses++;
+        spdlog::info("Engine::Core [ProgramCache] miss {:016x}", key);
+        return false;
+    }
+
+    // note : the file is the binary format followed by the binary
+    GLenum format{0};
+    file.read(reinterpret_cast<char *>(&format), sizeof(format));
+    const auto has_format = file.gcount() == static_cast<std::streamsize>(sizeof(format));
+    const std::vector<char> binary{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+
+    // note : a truncated file or an unknown format would raise a GL error, checked before the driver sees it
+    if (!has_format || binary.empty()
+        || std::find(m_formats->begin(), m_formats->end(), static_cast<GLint>(format)) == m_formats->end()) {
+        m_stats.misses++;
+        spdlog::warn("Engine::Core [ProgramCache] miss {:016x}, invalid binary", key);
+        return false;
+    }
+
+    CALL_OPEN_GL(::glProgramBinary(program, format, binary.data(), static_cast<GLsizei>(binary.size())));
+
+    GLint linked{GL_FALSE};
+    CALL_OPEN_GL(::glGetProgramiv(program, GL_LINK_STATUS, &linked));
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    m_stats.load_time += elapsed;
+
+    if (linked == GL_FALSE) {
+        m_stats.rejected++;
+        spdlog::warn("Engine::Core [ProgramCache] binary {:016x} rejected by the driver", key);
+        file.close();
+        std::error_code error;
+        std::filesystem::remove(path(key), error);
+        return false;
+    }
+
+    m_stats.hits++;
+    spdlog::info("Engine::Core [ProgramCache] hit {:016x} loaded in {:.3f} ms", key, to_ms(elapsed));
+    return true;
+}
+
+auto engine::core::ProgramCache::store(GLuint program, std::uint64_t key) -> void
+{
+    if (!isEnabled()) { return; }
+
+    GLint length{0};
+    CALL_OPEN_GL(::glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+    if (length <= 0) { return; }
+
+    GLenum format{0};
+    std::vector<char> binary(static_cast<std::size_t>(length));
+    CALL_OPEN_GL(::glGetProgramBinary(program, length, nullptr, &format, binary.data()));
+
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+    if (error) {
+        spdlog::warn(
+            "Engine::Core [ProgramCache] cannot create {}: {}", m_directory.string(), error.message());
+        return;
+    }
+
+    // note : written next to the final file under a name unique to this launch then renamed,
+    //        so a concurrent launch never reads nor writes a partial binary
+    const auto destination = path(key);
+    auto temporary = destination;
+    temporary += fmt::format(".{}.{:08x}.tmp", process_id(), std::random_device{}());
+    {
+        std::ofstream file{temporary, std::ios::binary};
+        file.write(reinterpret_cast<const char *>(&format), sizeof(format));
+        file.write(binary.data(), static_cast<std::streamsize>(binary.size()));
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temporary, error);
+            return;
+        }
+    }
+    std::filesystem::rename(temporary, destination, error);
+    if (error) { std::filesystem::remove(temporary, error); }
+}
+
+auto engine::core::ProgramCache::log() const -> void
+{
+    spdlog::info(
+        "Engine::Core [ProgramCache] {} hits, {} misses, {} rejected, load {:.3f} ms, compile {:.3f} ms",
+        m_stats.hits,
+        m_stats.misses,
+        m_stats.rejected,
+        to_ms(m_stats.load_time),
+        to_ms(m_stats.compile_time));
+}
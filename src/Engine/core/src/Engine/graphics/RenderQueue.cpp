@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include "Engine/graphics/RenderQueue.hpp"
+
+namespace {
+
+constexpr auto PROGRAM_BITS = 12u;
+constexpr auto MESH_BITS = 24u;
+constexpr auto DEPTH_BITS = 24u;
+
+constexpr auto mask(std::uint64_t value, unsigned bits) noexcept { return value & ((1ull << bits) - 1ull); }
+
+} // namespace
+
+auto engine::core::RenderQueue::makeKey(Pass pass, GLuint program, std::uint64_t mesh, float depth) noexcept
+    -> std::uint64_t
+{
+    constexpr auto DEPTH_MAX = static_cast<float>((1u << DEPTH_BITS) - 1u);
+
+    const auto bucket = static_cast<std::uint64_t>(std::clamp(depth, 0.0f, 1.0f) * DEPTH_MAX);
+    const auto program_bits = mask(program, PROGRAM_BITS);
+    // note : the 64 bits content hash is folded, the same mesh gets the same bits whatever its VAO
+    const auto mesh_bits = mask(mesh ^ (mesh >> MESH_BITS) ^ (mesh >> (2u * MESH_BITS)), MESH_BITS);
+
+    std::uint64_t key = static_cast<std::uint64_t>(pass) << 62u;
+    switch (pass) {
+    case Pass::SOLID:
+        key |= program_bits << 50u;
+        key |= bucket << 26u;
+        key |= mesh_bits << 2u;
+        break;
+    case Pass::TRANSLUCENT:
+        key |= mask(~bucket, DEPTH_BITS) << 38u;
+        key |= program_bits << 26u;
+        key |= mesh_bits << 2u;
+        break;
+    }
+    return key;
+}
+
+auto engine::core::RenderQueue::sort() -> void
+{
+    constexpr auto RADIX_BITS = 8u;
+    constexpr auto RADIX = 1u << RADIX_BITS;
+
+    m_scratch.resize(m_items.size());
+
+    // note : least significant digit first, the passes where every key share the same digit are skipped
+    for (auto shift = 0u; shift != 64u; shift += RADIX_BITS) {
+        std::array<std::size_t, RADIX> histogram{};
+        for (const auto &i : m_items) { histogram[(i.key >> shift) & (RADIX - 1u)]++; }
+        if (std::any_of(histogram.begin(), histogram.end(), [&](auto n) { return n == m_items.size(); })) {
+            continue;
+        }
+
+        std::size_t offset{0};
+        for (auto &bucket : histogram) { offset += std::exchange(bucket, offset); }
+        for (const auto &i : m_items) { m_scratch[histogram[(i.key >> shift) & (RADIX - 1u)]++] = i; }
+        m_items.swap(m_scratch);
+    }
+}
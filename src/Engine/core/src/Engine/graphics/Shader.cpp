@@ -1,22 +1,77 @@
 #include "Engine/graphics/Shader.hpp"
 
+auto engine::core::Shader::reflect() -> void
+{
+    // note : the shadow copy is sized for the largest type handled by setUniform
+    constexpr auto SHADOW_SIZE = static_cast<std::uint32_t>(sizeof(glm::mat4));
+
+    const auto reflect_table = [this](
+                                   GLenum count_param,
+                                   GLenum max_length_param,
+                                   auto get_active,
+                                   auto get_location) {
+        GLint count{0};
+        GLint max_length{0};
+        CALL_OPEN_GL(::glGetProgramiv(ID, count_param, &count));
+        CALL_OPEN_GL(::glGetProgramiv(ID, max_length_param, &max_length));
+
+        std::vector<Reflected> table;
+        std::string name(static_cast<std::size_t>(max_length), '\0');
+        for (GLuint i = 0; i != static_cast<GLuint>(count); i++) {
+            GLsizei length{0};
+            GLint size{0};
+            GLenum type{0};
+            CALL_OPEN_GL(get_active(ID, i, max_length, &length, &size, &type, name.data()));
+            auto reflected_name = name.substr(0, static_cast<std::size_t>(length));
+
+            // note : the members of the uniform blocks have no location
+            const auto location = get_location(ID, reflected_name.data());
+            if (location == -1) { continue; }
+
+            // note : arrays are reported as "name[0]"
+            if (const auto bracket = reflected_name.find('['); bracket != std::string::npos) {
+                reflected_name.resize(bracket);
+            }
+            const auto id = entt::hashed_string::value(reflected_name.data(), reflected_name.size());
+            table.push_back({id, std::move(reflected_name), location, type, 0u, false});
+        }
+        std::sort(table.begin(), table.end(), [](const auto &a, const auto &b) { return a.id < b.id; });
+        return table;
+    };
+
+    m_uniforms = reflect_table(
+        GL_ACTIVE_UNIFORMS, GL_ACTIVE_UNIFORM_MAX_LENGTH, ::glGetActiveUniform, ::glGetUniformLocation);
+    m_attributes = reflect_table(
+        GL_ACTIVE_ATTRIBUTES, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, ::glGetActiveAttrib, ::glGetAttribLocation);
+
+    for (auto i = 0ul; i != m_uniforms.size(); i++) {
+        m_uniforms[i].shadow_offset = static_cast<std::uint32_t>(i) * SHADOW_SIZE;
+    }
+    m_shadow.resize(m_uniforms.size() * SHADOW_SIZE);
+}
+
+// note : glProgramUniform does not require the program to be in use
+
+template<>
+auto engine::core::Shader::upload(GLint location, const bool &v) -> void
+{
+    CALL_OPEN_GL(::glProgramUniform1ui(ID, location, v));
+}
+
 template<>
-auto engine::core::Shader::setUniform(const std::string_view name, bool v) -> void
+auto engine::core::Shader::upload(GLint location, const float &v) -> void
 {
-    if (const auto location = ::glGetUniformLocation(ID, name.data()); location != -1)
-        CALL_OPEN_GL(::glUniform1ui(location, v));
+    CALL_OPEN_GL(::glProgramUniform1f(ID, location, v));
 }
 
 template<>
-auto engine::core::Shader::setUniform(const std::string_view name, float v) -> void
+auto engine::core::Shader::upload(GLint location, const glm::vec4 &vec) -> void
 {
-    if (const auto location = ::glGetUniformLocation(ID, name.data()); location != -1)
-        CALL_OPEN_GL(::glUniform1f(location, v));
+    CALL_OPEN_GL(::glProgramUniform4fv(ID, location, 1, glm::value_ptr(vec)));
 }
 
 template<>
-auto engine::core::Shader::setUniform(const std::string_view name, glm::mat4 mat) -> void
+auto engine::core::Shader::upload(GLint location, const glm::mat4 &mat) -> void
 {
-    if (const auto location = ::glGetUniformLocation(ID, name.data()); location != -1)
-        CALL_OPEN_GL(::glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat)));
+    CALL_OPEN_GL(::glProgramUniformMatrix4fv(ID, location, 1, GL_FALSE, glm::value_ptr(mat)));
 }
@@ -0,0 +1,346 @@
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <type_traits>
+
+#include <spdlog/spdlog.h>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/graphics/Frustum.hpp"
+#include "Engine/graphics/StaticBatcher.hpp"
+
+namespace {
+
+constexpr auto VERT_SH = R"(#version 450
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec4 inColors;
+
+layout (std140) uniform Frame {
+    mat4 view;
+    mat4 projection;
+    mat4 view_projection;
+    vec4 camera_position;
+    float time;
+};
+
+out vec4 fragColors;
+
+void main()
+{
+    gl_Position = view_projection * vec4(inPos, 1.0f);
+
+    fragColors = inColors;
+}
+)";
+
+constexpr auto FRAG_SH = R"(#version 450
+in vec4 fragColors;
+
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = fragColors;
+}
+)";
+
+constexpr GLuint BINDING{0};
+
+// note : the members of a strip, a loop or a fan would have to be separated by a primitive restart
+constexpr auto is_list(engine::api::VAO::DisplayMode mode) noexcept
+{
+    using Mode = engine::api::VAO::DisplayMode;
+    return mode == Mode::POINTS || mode == Mode::LINES || mode == Mode::TRIANGLES;
+}
+
+} // namespace
+
+engine::core::StaticBatcher::StaticBatcher(entt::registry &world) : m_world{world}, m_shader{VERT_SH, FRAG_SH}
+{
+    // note : the VAO is updated each time a buffer is attached to the entity
+    connect<api::Static, api::VAO, api::Transform, api::Tint4f>();
+    m_world.on_destroy<Member>().connect<&StaticBatcher::on_destroy_member>(*this);
+}
+
+engine::core::StaticBatcher::~StaticBatcher()
+{
+    m_world.on_destroy<Member>().disconnect<&StaticBatcher::on_destroy_member>(*this);
+    disconnect<api::Static, api::VAO, api::Transform, api::Tint4f>();
+
+    for (const auto &batch : m_batches) {
+        for (const auto buffer : {batch.vertex_buffer, batch.index_buffer}) {
+            CALL_OPEN_GL(::glDeleteBuffers(1, &buffer));
+        }
+        CALL_OPEN_GL(::glDeleteVertexArrays(1, &batch.vao));
+    }
+}
+
+auto engine::core::StaticBatcher::on_destroy_member(entt::registry &world, entt::entity entity) -> void
+{
+    m_batches[world.get<Member>(entity).batch].removed++;
+}
+
+auto engine::core::StaticBatcher::import(entt::entity entity) -> const Source *
+{
+    const auto &vao = m_world.get<api::VAO>(entity);
+    if (const auto it = m_sources.find(vao.content_hash); it != m_sources.end()) {
+        return it->second ? &*it->second : nullptr;
+    }
+
+    auto &source = m_sources[vao.content_hash];
+
+    const auto mesh = m_world.try_get<api::Vertices>(entity);
+    if (!mesh || mesh->count == 0) {
+        spdlog::warn("engine::core::StaticBatcher: {} has no vertices", entity);
+        return nullptr;
+    }
+    const std::size_t vertices{mesh->count};
+
+    // note : the buffers are not kept on the cpu, they are read back once per mesh
+    Source result;
+    for (const auto &point : mesh->read(api::VAO::Attribute::POSITION)) {
+        result.positions.emplace_back(point);
+    }
+    result.colors = mesh->read(api::VAO::Attribute::COLOR);
+
+    // note : the meshes without EBO are drawn with the sequence of their vertices
+    if (const auto ebo = m_world.try_get<api::EBO>(entity); ebo) {
+        result.indices = ebo->read();
+    } else {
+        result.indices.resize(vertices);
+        std::iota(result.indices.begin(), result.indices.end(), 0u);
+    }
+
+    // note : once merged, an index out of the mesh would read the vertices of another member
+    const auto outside = [vertices](auto i) { return i >= vertices; };
+    if (std::any_of(result.indices.begin(), result.indices.end(), outside)) {
+        spdlog::warn("engine::core::StaticBatcher: the indices of {} are out of its vertices", entity);
+        return nullptr;
+    }
+
+    source = std::move(result);
+    return &*source;
+}
+
+auto engine::core::StaticBatcher::getBatch(api::VAO::DisplayMode mode) -> std::uint32_t
+{
+    for (std::uint32_t i = 0; i != m_batches.size(); i++) {
+        if (m_batches[i].mode == mode) { return i; }
+    }
+
+    auto &batch = m_batches.emplace_back();
+    batch.mode = mode;
+
+    CALL_OPEN_GL(::glCreateVertexArrays(1, &batch.vao));
+    CALL_OPEN_GL(::glCreateBuffers(1, &batch.vertex_buffer));
+    CALL_OPEN_GL(::glCreateBuffers(1, &batch.index_buffer));
+    api::debug_label(GL_VERTEX_ARRAY, batch.vao, "StaticBatcher");
+    api::debug_label(GL_BUFFER, batch.vertex_buffer, "StaticBatcher vertices");
+    api::debug_label(GL_BUFFER, batch.index_buffer, "StaticBatcher indices");
+
+    const auto position = static_cast<GLuint>(api::VAO::Attribute::POSITION);
+    CALL_OPEN_GL(::glEnableVertexArrayAttrib(batch.vao, position));
+    CALL_OPEN_GL(::glVertexArrayAttribFormat(
+        batch.vao, position, 3, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, position))));
+    CALL_OPEN_GL(::glVertexArrayAttribBinding(batch.vao, position, BINDING));
+
+    const auto color = static_cast<GLuint>(api::VAO::Attribute::COLOR);
+    CALL_OPEN_GL(::glEnableVertexArrayAttrib(batch.vao, color));
+    CALL_OPEN_GL(::glVertexArrayAttribFormat(
+        batch.vao, color, 4, GL_FLOAT, GL_FALSE, static_cast<GLuint>(offsetof(Vertex, color))));
+    CALL_OPEN_GL(::glVertexArrayAttribBinding(batch.vao, color, BINDING));
+
+    // note : the buffers keep their name when they grow, the bindings stay valid
+    CALL_OPEN_GL(::glVertexArrayVertexBuffer(
+        batch.vao, BINDING, batch.vertex_buffer, 0, static_cast<GLsizei>(sizeof(Vertex))));
+    CALL_OPEN_GL(::glVertexArrayElementBuffer(batch.vao, batch.index_buffer));
+
+    return static_cast<std::uint32_t>(m_batches.size() - 1);
+}
+
+auto engine::core::StaticBatcher::write(
+    Batch &batch,
+    const Member &member,
+    const Source &source,
+    const glm::mat4 &model,
+    const glm::vec4 &tint) -> void
+{
+    for (std::size_t i = 0; i != member.vertex_count; i++) {
+        const auto position = glm::vec3{model * glm::vec4{source.positions[i], 1.0f}};
+        batch.vertices[member.first_vertex + i] = {position, source.colors[i] * tint};
+        batch.min = glm::min(batch.min, position);
+        batch.max = glm::max(batch.max, position);
+    }
+    batch.dirty_vertices.add(member.first_vertex, member.first_vertex + member.vertex_count);
+}
+
+auto engine::core::StaticBatcher::repack(std::uint32_t index) -> void
+{
+    auto &batch = m_batches[index];
+
+    std::vector<Vertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::vector<Entry> entries;
+    vertices.reserve(batch.vertices.size());
+    indices.reserve(batch.indices.size());
+    entries.reserve(batch.entries.size() - std::min(batch.removed, batch.entries.size()));
+
+    batch.min = glm::vec3{std::numeric_limits<float>::max()};
+    batch.max = glm::vec3{-std::numeric_limits<float>::max()};
+
+    for (const auto &entry : batch.entries) {
+        // note : an entity moved to the end of the batch has an entry for each of its ranges
+        const auto member = m_world.valid(entry.entity) ? m_world.try_get<Member>(entry.entity) : nullptr;
+        if (!member || member->batch != index || member->first_vertex != entry.first_vertex) { continue; }
+
+        const auto first_vertex = static_cast<std::uint32_t>(vertices.size());
+        const auto first_index = static_cast<std::uint32_t>(indices.size());
+
+        const auto begin = batch.vertices.begin() + member->first_vertex;
+        vertices.insert(vertices.end(), begin, begin + member->vertex_count);
+        for (auto i = member->first_index; i != member->first_index + member->index_count; i++) {
+            indices.push_back(batch.indices[i] - member->first_vertex + first_vertex);
+        }
+        for (auto i = first_vertex; i != vertices.size(); i++) {
+            batch.min = glm::min(batch.min, vertices[i].position);
+            batch.max = glm::max(batch.max, vertices[i].position);
+        }
+
+        member->first_vertex = first_vertex;
+        member->first_index = first_index;
+        entries.push_back({entry.entity, first_vertex});
+    }
+
+    batch.vertices.swap(vertices);
+    batch.indices.swap(indices);
+    batch.entries.swap(entries);
+    batch.removed = 0;
+    batch.dirty_vertices.add(0, batch.vertices.size());
+    batch.dirty_indices.add(0, batch.indices.size());
+}
+
+auto engine::core::StaticBatcher::upload(Batch &batch) -> void
+{
+    const auto upload_range = [](GLuint buffer, std::size_t &capacity, const auto &data, Range &dirty) {
+        if (dirty.empty()) { return; }
+
+        constexpr auto SIZE = sizeof(typename std::decay_t<decltype(data)>::value_type);
+        if (data.size() > capacity) {
+            capacity = std::max(data.size(), capacity * 2);
+            CALL_OPEN_GL(::glNamedBufferData(
+                buffer, static_cast<GLsizeiptr>(capacity * SIZE), nullptr, GL_STATIC_DRAW));
+            dirty = {0, data.size()};
+        }
+
+        // note : a repack may have shrunk the data below the range modified before
+        const auto last = std::min(dirty.last, data.size());
+        if (dirty.first < last) {
+            CALL_OPEN_GL(::glNamedBufferSubData(
+                buffer,
+                static_cast<GLintptr>(dirty.first * SIZE),
+                static_cast<GLsizeiptr>((last - dirty.first) * SIZE),
+                data.data() + dirty.first));
+        }
+        dirty = {};
+    };
+
+    upload_range(batch.vertex_buffer, batch.vertex_capacity, batch.vertices, batch.dirty_vertices);
+    upload_range(batch.index_buffer, batch.index_capacity, batch.indices, batch.dirty_indices);
+}
+
+auto engine::core::StaticBatcher::update() -> void
+{
+    static constexpr auto NO_TINT = glm::vec4{1.0f, 1.0f, 1.0f, 1.0f};
+
+    m_stats.written = 0;
+    m_stats.repacked = 0;
+
+    std::sort(m_dirty.begin(), m_dirty.end());
+    m_dirty.erase(std::unique(m_dirty.begin(), m_dirty.end()), m_dirty.end());
+
+    for (const auto entity : m_dirty) {
+        if (!m_world.valid(entity)) { continue; }
+
+        const auto vao = m_world.try_get<api::VAO>(entity);
+        const auto transform = m_world.try_get<api::Transform>(entity);
+        const auto tint = m_world.try_get<api::Tint4f>(entity);
+        const auto batchable = m_world.has<api::Static>(entity) && vao && transform && is_list(vao->mode)
+                               && (!tint || tint->vec.a >= 1.0f);
+        const auto source = batchable ? import(entity) : nullptr;
+        if (!source) {
+            m_world.remove_if_exists<Member>(entity);
+            continue;
+        }
+
+        // note : copied out, removing the Member moves the entity in the owning group of the renderables,
+        //        which swaps its VAO and Transform with another entity
+        const auto mode = vao->mode;
+        const auto content_hash = vao->content_hash;
+        const auto model = transform->world;
+        const auto color = tint ? tint->vec : NO_TINT;
+        const auto member = m_world.try_get<Member>(entity);
+        if (member && member->content_hash == content_hash && m_batches[member->batch].mode == mode) {
+            // note : the same mesh in the same batch, the vertices are rewritten in place
+            write(m_batches[member->batch], *member, *source, model, color);
+        } else {
+            m_world.remove_if_exists<Member>(entity);
+
+            const auto index = getBatch(mode);
+            auto &batch = m_batches[index];
+            const Member added{
+                index,
+                static_cast<std::uint32_t>(batch.vertices.size()),
+                static_cast<std::uint32_t>(source->positions.size()),
+                static_cast<std::uint32_t>(batch.indices.size()),
+                static_cast<std::uint32_t>(source->indices.size()),
+                content_hash};
+
+            batch.vertices.resize(batch.vertices.size() + added.vertex_count);
+            for (const auto i : source->indices) { batch.indices.push_back(i + added.first_vertex); }
+            batch.dirty_indices.add(added.first_index, batch.indices.size());
+            batch.entries.push_back({entity, added.first_vertex});
+            write(batch, added, *source, model, color);
+
+            m_world.emplace<Member>(entity, added);
+        }
+        m_stats.written++;
+    }
+    m_dirty.clear();
+
+    m_stats.batches = m_batches.size();
+    m_stats.members = 0;
+    m_stats.vertices = 0;
+    m_stats.indices = 0;
+    for (std::uint32_t i = 0; i != m_batches.size(); i++) {
+        auto &batch = m_batches[i];
+        if (batch.removed != 0) {
+            repack(i);
+            m_stats.repacked++;
+        }
+        upload(batch);
+
+        m_stats.members += batch.entries.size();
+        m_stats.vertices += batch.vertices.size();
+        m_stats.indices += batch.indices.size();
+    }
+}
+
+auto engine::core::StaticBatcher::draw(const glm::mat4 &view_projection, StateTracker &state) -> void
+{
+    m_stats.draw_calls = 0;
+    if (m_stats.indices == 0) { return; }
+
+    const Frustum frustum{view_projection};
+
+    m_shader.use(state);
+    for (const auto &batch : m_batches) {
+        if (batch.indices.empty() || frustum.classify(batch.min, batch.max) == Frustum::Result::OUTSIDE) {
+            continue;
+        }
+
+        state.bindVertexArray(batch.vao);
+        state.drawElements(static_cast<GLenum>(batch.mode), static_cast<GLsizei>(batch.indices.size()));
+        m_stats.draw_calls++;
+    }
+}
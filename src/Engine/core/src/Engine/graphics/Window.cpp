@@ -1,10 +1,15 @@
-#define STB_IMAGE_WRITE_IMPLEMENTATION
-#include <stb_image_write.h>
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <Engine/helpers/debug.hpp>
 
 #include "Engine/graphics/Window.hpp"
 
-engine::core::Window::Window(int width, int height, const std::string_view name)
+engine::core::Window::Window(int width, int height, const std::string_view name, bool headless) :
+    m_headless{headless}
 {
+    ::glfwWindowHint(GLFW_VISIBLE, headless ? GLFW_FALSE : GLFW_TRUE);
     m_handle = ::glfwCreateWindow(width, height, name.data(), nullptr, nullptr);
     if (m_handle == nullptr) { throw std::logic_error("Engine::Window initialization failed"); }
     ::glfwMakeContextCurrent(m_handle);
@@ -24,8 +29,68 @@ auto engine::core::Window::create_ui_context() -> bool
     return true;
 }
 
+auto engine::core::Window::create_offscreen_target() -> bool
+{
+    const auto size = getSize<int>();
+
+    CALL_OPEN_GL(::glCreateRenderbuffers(1, &m_color));
+    CALL_OPEN_GL(::glNamedRenderbufferStorage(m_color, GL_RGBA8, size.x, size.y));
+    CALL_OPEN_GL(::glCreateRenderbuffers(1, &m_depth));
+    CALL_OPEN_GL(::glNamedRenderbufferStorage(m_depth, GL_DEPTH24_STENCIL8, size.x, size.y));
+
+    CALL_OPEN_GL(::glCreateFramebuffers(1, &m_framebuffer));
+    api::debug_label(GL_FRAMEBUFFER, m_framebuffer, "Offscreen target");
+    CALL_OPEN_GL(
+        ::glNamedFramebufferRenderbuffer(m_framebuffer, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_color));
+    CALL_OPEN_GL(::glNamedFramebufferRenderbuffer(
+        m_framebuffer, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depth));
+
+    if (::glCheckNamedFramebufferStatus(m_framebuffer, GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        return false;
+    }
+
+    // note : nothing else binds a framebuffer, the draws and the screenshots all go through this one
+    CALL_OPEN_GL(::glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer));
+    CALL_OPEN_GL(::glViewport(0, 0, size.x, size.y));
+
+    return true;
+}
+
 engine::core::Window::~Window()
 {
+    std::size_t dropped{0};
+    if (m_readback.has_value()) {
+        m_readback->flush(m_encoder);
+        dropped = m_readback->getDropped();
+        m_readback.reset();
+    }
+
+    if (m_recording.has_value()) {
+        const auto stats = m_encoder.getStats();
+        const auto recorded = m_recording->sequence - std::min(dropped, m_recording->sequence);
+        spdlog::info(
+            "Engine::Window {} frames recorded, queue peak {}, {} stalls for {} ms",
+            recorded,
+            stats.peak,
+            stats.stalls,
+            std::chrono::duration_cast<std::chrono::milliseconds>(stats.stalled).count());
+
+        // note : the recording starts before the first frame, every rendered frame has its sequence
+        if (recorded != m_frame_count) {
+            spdlog::error(
+                "Engine::Window {} frames rendered but {} recorded in '{}'",
+                m_frame_count,
+                recorded,
+                m_recording->directory.string());
+        }
+    }
+
+    if (m_framebuffer != 0) {
+        CALL_OPEN_GL(::glDeleteFramebuffers(1, &m_framebuffer));
+        CALL_OPEN_GL(::glDeleteRenderbuffers(1, &m_color));
+        CALL_OPEN_GL(::glDeleteRenderbuffers(1, &m_depth));
+    }
+
     ::ImGui_ImplOpenGL3_Shutdown();
     ::ImGui_ImplGlfw_Shutdown();
 
@@ -36,39 +101,80 @@ engine::core::Window::~Window()
 
 auto engine::core::Window::isOpen() const noexcept -> bool
 {
+    if (m_frame_limit != 0 && m_frame_count >= m_frame_limit) { return false; }
     return ::glfwWindowShouldClose(m_handle) == GLFW_FALSE;
 }
 
-auto engine::core::Window::render() -> void { ::glfwSwapBuffers(m_handle); }
+auto engine::core::Window::isIconified() const noexcept -> bool
+{
+    return !m_headless && ::glfwGetWindowAttrib(m_handle, GLFW_ICONIFIED) == GLFW_TRUE;
+}
+
+auto engine::core::Window::render() -> void
+{
+    // note : read before the swap, the back buffer is undefined afterward
+    capture();
+
+    m_frame_count++;
+    // note : the hidden window is never presented, the frame stays in the offscreen framebuffer
+    if (!m_headless) { ::glfwSwapBuffers(m_handle); }
+}
 
 auto engine::core::Window::screenshot(const std::string_view filename) -> bool
 {
-    GLint viewport[4];
+    if (m_screenshot.has_value()) { return false; }
+    m_screenshot = std::string{filename};
+    return true;
+}
 
+auto engine::core::Window::record(const std::filesystem::path &directory, ImageEncoder::Format format) -> bool
+{
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) { return false; }
+
+    std::ofstream index{directory / "index.csv"};
+    if (!index) { return false; }
+    index << "sequence,file,width,height\n";
+
+    m_recording.emplace(Recording{directory, format, 0, std::move(index)});
+    return true;
+}
+
+auto engine::core::Window::capture() -> void
+{
+    if (!m_screenshot.has_value() && !m_recording.has_value()) {
+        if (m_readback.has_value()) { m_readback->poll(m_encoder); }
+        return;
+    }
+
+    GLint viewport[4];
     CALL_OPEN_GL(::glGetIntegerv(GL_VIEWPORT, viewport));
-    const auto &x = viewport[0];
-    const auto &y = viewport[1];
-    const auto &width = viewport[2];
-    const auto &height = viewport[3];
-
-    constexpr auto CHANNEL = 4ul;
-    std::vector<char> pixels(static_cast<std::size_t>(width * height) * CHANNEL);
-
-    CALL_OPEN_GL(::glPixelStorei(GL_PACK_ALIGNMENT, 1));
-    CALL_OPEN_GL(::glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
-
-    std::array<char, CHANNEL> pixel;
-    for (auto j = 0; j < height / 2; ++j)
-        for (auto i = 0; i < width; ++i) {
-            const auto top = static_cast<std::size_t>(i + j * width) * pixel.size();
-            const auto bottom = static_cast<std::size_t>(i + (height - j - 1) * width) * pixel.size();
-
-            std::memcpy(pixel.data(), pixels.data() + top, pixel.size());
-            std::memcpy(pixels.data() + top, pixels.data() + bottom, pixel.size());
-            std::memcpy(pixels.data() + bottom, pixel.data(), pixel.size());
-        }
 
-    return !!::stbi_write_png(filename.data(), width, height, 4, pixels.data(), 0);
+    if (!m_readback.has_value()) { m_readback.emplace(); }
+
+    const auto read = [this, &viewport](std::string filename, ImageEncoder::Format format) {
+        // note : no frame is dropped, the oldest copy is waited for when every slot is in flight
+        if (!m_readback->read(viewport[0], viewport[1], viewport[2], viewport[3], filename, format)) {
+            m_readback->reclaim(m_encoder);
+            m_readback->read(viewport[0], viewport[1], viewport[2], viewport[3], std::move(filename), format);
+        }
+    };
+
+    if (m_screenshot.has_value()) {
+        read(std::move(*m_screenshot), ImageEncoder::Format::PNG);
+        m_screenshot.reset();
+    }
+
+    if (m_recording.has_value()) {
+        auto &[directory, format, sequence, index] = *m_recording;
+        const auto file = fmt::format("{:06}.{}", sequence, ImageEncoder::extension(format));
+        index << sequence << ',' << file << ',' << viewport[2] << ',' << viewport[3] << '\n';
+        read((directory / file).string(), format);
+        sequence++;
+    }
+
+    m_readback->poll(m_encoder);
 }
 
 template<>
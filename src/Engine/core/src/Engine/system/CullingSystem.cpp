@@ -0,0 +1,69 @@
+#include <algorithm>
+
+#include "Engine/system/CullingSystem.hpp"
+
+engine::core::CullingSystem::CullingSystem(entt::registry &world) : m_world{world}
+{
+    connect<api::AABB, api::Transform>();
+    m_world.on_destroy<Proxy>().connect<&CullingSystem::on_destroy_proxy>(*this);
+}
+
+engine::core::CullingSystem::~CullingSystem()
+{
+    m_world.on_destroy<Proxy>().disconnect<&CullingSystem::on_destroy_proxy>(*this);
+    disconnect<api::AABB, api::Transform>();
+}
+
+auto engine::core::CullingSystem::transform(const api::AABB &local, const glm::mat4 &world) noexcept
+    -> DynamicBVH::Box
+{
+    // note : Arvo, the extent of the transformed box is the projection of the extent on the absolute axes
+    const auto center = glm::vec3{world * glm::vec4{(local.min + local.max) * 0.5f, 1.0f}};
+    const auto extent = (local.max - local.min) * 0.5f;
+    const auto world_extent = glm::abs(glm::vec3{world[0]}) * extent.x
+                              + glm::abs(glm::vec3{world[1]}) * extent.y
+                              + glm::abs(glm::vec3{world[2]}) * extent.z;
+    return {center - world_extent, center + world_extent};
+}
+
+auto engine::core::CullingSystem::on_destroy_proxy(entt::registry &world, entt::entity entity) -> void
+{
+    m_tree.remove(world.get<Proxy>(entity).leaf);
+}
+
+auto engine::core::CullingSystem::update(const glm::mat4 &view_projection) -> void
+{
+    m_frame++;
+    m_stats = {};
+
+    std::sort(m_dirty.begin(), m_dirty.end());
+    m_dirty.erase(std::unique(m_dirty.begin(), m_dirty.end()), m_dirty.end());
+
+    for (const auto entity : m_dirty) {
+        if (!m_world.valid(entity)) { continue; }
+
+        const auto local = m_world.try_get<api::AABB>(entity);
+        const auto world_transform = m_world.try_get<api::Transform>(entity);
+        if (!local || !world_transform) {
+            m_world.remove_if_exists<Proxy>(entity);
+            continue;
+        }
+
+        const auto box = transform(*local, world_transform->world);
+        if (const auto proxy = m_world.try_get<Proxy>(entity); proxy) {
+            m_stats.reinserted += m_tree.move(proxy->leaf, box) ? 1 : 0;
+        } else {
+            m_world.emplace<Proxy>(entity, Proxy{m_tree.insert(box, entity), 0u});
+        }
+    }
+    m_dirty.clear();
+
+    if (!m_enabled) { return; }
+
+    m_tree.query(Frustum{view_projection}, [this](entt::entity entity) {
+        m_world.get<Proxy>(entity).visible_frame = m_frame;
+        m_stats.visible++;
+    });
+    m_stats.culled = m_tree.size() - m_stats.visible;
+    m_stats.height = m_tree.getHeight();
+}
@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <utility>
+
+#include "Engine/system/DynamicBVH.hpp"
+
+namespace {
+
+using Box = engine::core::DynamicBVH::Box;
+
+auto merge(const Box &a, const Box &b) noexcept -> Box
+{
+    return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+auto contains(const Box &outer, const Box &inner) noexcept
+{
+    return glm::all(glm::lessThanEqual(outer.min, inner.min))
+           && glm::all(glm::lessThanEqual(inner.max, outer.max));
+}
+
+// note : half of the surface area, used as the cost of the node
+auto area(const Box &box) noexcept
+{
+    const auto d = box.max - box.min;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+} // namespace
+
+auto engine::core::DynamicBVH::allocate() -> std::uint32_t
+{
+    if (m_free == NIL) {
+        m_nodes.push_back({});
+        m_nodes.back().height = -1;
+        m_nodes.back().parent = NIL;
+        m_free = static_cast<std::uint32_t>(m_nodes.size() - 1);
+    }
+
+    const auto index = m_free;
+    auto &node = m_nodes[index];
+    m_free = node.parent;
+    node.parent = NIL;
+    node.left = NIL;
+    node.right = NIL;
+    node.height = 0;
+    node.entity = entt::null;
+    return index;
+}
+
+auto engine::core::DynamicBVH::release(std::uint32_t index) -> void
+{
+    m_nodes[index].parent = m_free;
+    m_nodes[index].height = -1;
+    m_free = index;
+}
+
+auto engine::core::DynamicBVH::insert(const Box &box, entt::entity entity) -> std::uint32_t
+{
+    const auto leaf = allocate();
+    m_nodes[leaf].box = {box.min - glm::vec3{MARGIN}, box.max + glm::vec3{MARGIN}};
+    m_nodes[leaf].entity = entity;
+    insertLeaf(leaf);
+    m_leaves++;
+    return leaf;
+}
+
+auto engine::core::DynamicBVH::remove(std::uint32_t leaf) -> void
+{
+    removeLeaf(leaf);
+    release(leaf);
+    m_leaves--;
+}
+
+auto engine::core::DynamicBVH::move(std::uint32_t leaf, const Box &box) -> bool
+{
+    if (contains(m_nodes[leaf].box, box)) { return false; }
+
+    removeLeaf(leaf);
+    m_nodes[leaf].box = {box.min - glm::vec3{MARGIN}, box.max + glm::vec3{MARGIN}};
+    insertLeaf(leaf);
+    return true;
+}
+
+auto engine::core::DynamicBVH::insertLeaf(std::uint32_t leaf) -> void
+{
+    if (m_root == NIL) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NIL;
+        return;
+    }
+
+    // note : descend toward the sibling which minimizes the increase of the surface area
+    const auto box = m_nodes[leaf].box;
+    auto index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const auto &node = m_nodes[index];
+        const auto combined = area(merge(node.box, box));
+
+        const auto cost = 2.0f * combined;
+        const auto inheritance = 2.0f * (combined - area(node.box));
+
+        const auto child_cost = [this, &box, inheritance](std::uint32_t child) {
+            const auto &c = m_nodes[child];
+            const auto merged = area(merge(c.box, box));
+            return (c.isLeaf() ? merged : merged - area(c.box)) + inheritance;
+        };
+        const auto cost_left = child_cost(node.left);
+        const auto cost_right = child_cost(node.right);
+
+        if (cost < cost_left && cost < cost_right) { break; }
+        index = cost_left < cost_right ? node.left : node.right;
+    }
+
+    const auto sibling = index;
+    const auto old_parent = m_nodes[sibling].parent;
+    const auto new_parent = allocate();
+    m_nodes[new_parent].parent = old_parent;
+    m_nodes[new_parent].box = merge(box, m_nodes[sibling].box);
+    m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+    m_nodes[new_parent].left = sibling;
+    m_nodes[new_parent].right = leaf;
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    if (old_parent == NIL) {
+        m_root = new_parent;
+    } else if (m_nodes[old_parent].left == sibling) {
+        m_nodes[old_parent].left = new_parent;
+    } else {
+        m_nodes[old_parent].right = new_parent;
+    }
+
+    refit(m_nodes[leaf].parent);
+}
+
+auto engine::core::DynamicBVH::removeLeaf(std::uint32_t leaf) -> void
+{
+    if (leaf == m_root) {
+        m_root = NIL;
+        return;
+    }
+
+    const auto parent = m_nodes[leaf].parent;
+    const auto grand_parent = m_nodes[parent].parent;
+    const auto sibling = m_nodes[parent].left == leaf ? m_nodes[parent].right : m_nodes[parent].left;
+
+    release(parent);
+    m_nodes[sibling].parent = grand_parent;
+
+    if (grand_parent == NIL) {
+        m_root = sibling;
+        return;
+    }
+
+    if (m_nodes[grand_parent].left == parent) {
+        m_nodes[grand_parent].left = sibling;
+    } else {
+        m_nodes[grand_parent].right = sibling;
+    }
+    refit(grand_parent);
+}
+
+auto engine::core::DynamicBVH::refit(std::uint32_t index) -> void
+{
+    while (index != NIL) {
+        index = balance(index);
+
+        auto &node = m_nodes[index];
+        const auto &left = m_nodes[node.left];
+        const auto &right = m_nodes[node.right];
+        node.height = 1 + std::max(left.height, right.height);
+        node.box = merge(left.box, right.box);
+
+        index = node.parent;
+    }
+}
+
+auto engine::core::DynamicBVH::balance(std::uint32_t a) -> std::uint32_t
+{
+    if (m_nodes[a].isLeaf() || m_nodes[a].height < 2) { return a; }
+
+    const auto b = m_nodes[a].left;
+    const auto c = m_nodes[a].right;
+    const auto difference = m_nodes[c].height - m_nodes[b].height;
+
+    // note : promote the highest child in place of a, a takes the lowest grand child of the promoted node
+    const auto rotate = [this, a](std::uint32_t up, std::uint32_t other, bool up_is_right) {
+        const auto f = m_nodes[up].left;
+        const auto g = m_nodes[up].right;
+
+        m_nodes[up].left = a;
+        m_nodes[up].parent = m_nodes[a].parent;
+        m_nodes[a].parent = up;
+
+        if (const auto parent = m_nodes[up].parent; parent == NIL) {
+            m_root = up;
+        } else if (m_nodes[parent].left == a) {
+            m_nodes[parent].left = up;
+        } else {
+            m_nodes[parent].right = up;
+        }
+
+        const auto [keep, give] = m_nodes[f].height > m_nodes[g].height ? std::pair{f, g} : std::pair{g, f};
+        m_nodes[up].right = keep;
+        if (up_is_right) {
+            m_nodes[a].right = give;
+        } else {
+            m_nodes[a].left = give;
+        }
+        m_nodes[give].parent = a;
+
+        m_nodes[a].box = merge(m_nodes[other].box, m_nodes[give].box);
+        m_nodes[a].height = 1 + std::max(m_nodes[other].height, m_nodes[give].height);
+        m_nodes[up].box = merge(m_nodes[a].box, m_nodes[keep].box);
+        m_nodes[up].height = 1 + std::max(m_nodes[a].height, m_nodes[keep].height);
+        return up;
+    };
+
+    if (difference > 1) { return rotate(c, b, true); }
+    if (difference < -1) { return rotate(b, c, false); }
+    return a;
+}
@@ -0,0 +1,49 @@
+#include <algorithm>
+
+#include "Engine/graphics/StaticBatcher.hpp"
+#include "Engine/system/LODSystem.hpp"
+
+auto engine::core::LODSystem::update(const FrameUniforms::Block &frame, const CullingSystem &culling) -> void
+{
+    m_stats = {};
+
+    // note : a perspective projection scales the size by 1 / distance, an orthographic one does not
+    const auto perspective = frame.projection[3][3] == 0.0f;
+    const auto camera = glm::vec3{frame.camera_position};
+
+    // note : the batched entities are always drawn at full detail
+    m_world.view<api::LOD, api::VAO, api::Transform>(entt::exclude<StaticBatcher::Member>).each(
+        [this, &frame, &culling, perspective, &camera](
+            const auto entity, api::LOD &lod, const api::VAO &vao, const api::Transform &transform) {
+            if (!culling.isVisible(entity)) { return; }
+
+            if (!m_enabled) {
+                lod.current = 0;
+            } else {
+                const auto scale = std::max(
+                    {glm::length(glm::vec3{transform.world[0]}),
+                     glm::length(glm::vec3{transform.world[1]}),
+                     glm::length(glm::vec3{transform.world[2]})});
+                const auto center = glm::vec3{transform.world[3]};
+
+                auto size = lod.radius * scale * frame.projection[1][1];
+                if (perspective) { size /= std::max(glm::distance(camera, center), 0.001f); }
+
+                // note : the level only changes once the size is past the margin around the threshold
+                const auto coarser = [&lod](float value) {
+                    return lod.current + 1 < lod.count
+                           && value < THRESHOLDS[lod.current + 1] * (1.0f - HYSTERESIS);
+                };
+                const auto finer = [&lod](float value) {
+                    return lod.current > 0 && value > THRESHOLDS[lod.current] * (1.0f + HYSTERESIS);
+                };
+                while (coarser(size)) { lod.current++; }
+                while (finer(size)) { lod.current--; }
+            }
+
+            const auto level = select(vao, &lod);
+            m_stats.entities[lod.current]++;
+            m_stats.triangles += static_cast<std::size_t>(level.count) / 3;
+            m_stats.full_triangles += static_cast<std::size_t>(lod.levels[0].count) / 3;
+        });
+}
@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <numeric>
+
+#include <spdlog/spdlog.h>
+
+#include "Engine/system/OcclusionSystem.hpp"
+
+engine::core::OcclusionSystem::OcclusionSystem(entt::registry &world, std::size_t workers) : m_world{world}
+{
+    if (workers == 0) { workers = std::max(std::thread::hardware_concurrency() / 2u, 1u); }
+    workers = std::min(workers, OcclusionBuffer::BANDS - 1);
+
+    m_workers.reserve(workers);
+    for (auto i = 0ul; i != workers; i++) { m_workers.emplace_back(&OcclusionSystem::run, this); }
+}
+
+engine::core::OcclusionSystem::~OcclusionSystem()
+{
+    {
+        const std::lock_guard lock{m_mutex};
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto &worker : m_workers) { worker.join(); }
+}
+
+auto engine::core::OcclusionSystem::import(entt::entity entity, const api::VAO &vao) -> const Mesh *
+{
+    if (const auto it = m_meshes.find(vao.content_hash); it != m_meshes.end()) {
+        return it->second ? &*it->second : nullptr;
+    }
+
+    auto &mesh = m_meshes[vao.content_hash];
+
+    const auto vertices = m_world.try_get<api::Vertices>(entity);
+    if (!vertices) {
+        spdlog::warn("engine::core::OcclusionSystem: the occluder {} has no vertices", entity);
+        return nullptr;
+    }
+
+    // note : the buffers are not kept on the cpu, they are read back once per mesh
+    Mesh result;
+    for (const auto &point : vertices->read(api::VAO::Attribute::POSITION)) {
+        result.positions.emplace_back(point);
+    }
+
+    if (const auto ebo = m_world.try_get<api::EBO>(entity); ebo) {
+        result.indices = ebo->read();
+    } else {
+        result.indices.resize(result.positions.size());
+        std::iota(result.indices.begin(), result.indices.end(), 0u);
+    }
+
+    mesh = std::move(result);
+    return &*mesh;
+}
+
+auto engine::core::OcclusionSystem::run() -> void
+{
+    std::uint64_t generation{0};
+    while (true) {
+        {
+            std::unique_lock lock{m_mutex};
+            m_start.wait(lock, [this, &generation] { return m_stop || m_generation != generation; });
+            if (m_stop) { return; }
+            generation = m_generation;
+        }
+        work();
+    }
+}
+
+auto engine::core::OcclusionSystem::work() -> void
+{
+    for (auto band = m_next_band++; band < OcclusionBuffer::BANDS; band = m_next_band++) {
+        m_buffer.rasterize(band);
+        if (--m_remaining == 0) {
+            const std::lock_guard lock{m_mutex};
+            m_done.notify_all();
+        }
+    }
+}
+
+auto engine::core::OcclusionSystem::update(const glm::mat4 &view_projection, const CullingSystem &culling)
+    -> void
+{
+    m_stats = {};
+    if (!m_enabled) { return; }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    m_buffer.begin(view_projection);
+    for (const auto entity : m_world.view<api::Occluder>()) {
+        const auto vao = m_world.try_get<api::VAO>(entity);
+        const auto transform = m_world.try_get<api::Transform>(entity);
+        if (!vao || !transform || vao->mode != api::VAO::DisplayMode::TRIANGLES) { continue; }
+        if (!culling.isVisible(entity)) { continue; }
+
+        if (const auto mesh = import(entity, *vao); mesh) {
+            m_buffer.addMesh(transform->world, mesh->positions, mesh->indices);
+            m_stats.occluders++;
+        }
+    }
+    m_stats.triangles = m_buffer.getTriangleCount();
+
+    // note : the triangles are only read by the workers once the first band is handed out
+    m_remaining = OcclusionBuffer::BANDS;
+    {
+        const std::lock_guard lock{m_mutex};
+        m_next_band = 0;
+        m_generation++;
+    }
+    m_start.notify_all();
+
+    work();
+    {
+        std::unique_lock lock{m_mutex};
+        m_done.wait(lock, [this] { return m_remaining == 0; });
+    }
+
+    m_stats.raster_time = std::chrono::steady_clock::now() - start;
+}
+
+auto engine::core::OcclusionSystem::test(entt::entity entity) -> bool
+{
+    if (!m_enabled) { return true; }
+
+    const auto bounds = m_world.try_get<api::AABB>(entity);
+    const auto transform = m_world.try_get<api::Transform>(entity);
+    if (!bounds || !transform || m_world.has<api::Occluder>(entity)) { return true; }
+
+    m_stats.tested++;
+    const auto visible = m_buffer.isVisible(bounds->min, bounds->max, transform->world);
+    if (!visible) { m_stats.occluded++; }
+    return visible;
+}
@@ -0,0 +1,104 @@
+#include <array>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#    include <intrin.h>
+#endif
+
+#include "Engine/system/TransformKernel.hpp"
+
+namespace {
+
+constexpr auto DEG_TO_RAD = 0.01745329251994329576923690768489f;
+
+} // namespace
+
+auto engine::core::simd::detect_isa() noexcept -> ISA
+{
+    static const auto isa = []() {
+#if defined(ENGINE_TRANSFORM_KERNEL_X86)
+#    if defined(_MSC_VER)
+        std::array<int, 4> info{};
+        ::__cpuid(info.data(), 0);
+        const auto max_leaf = info[0];
+
+        ::__cpuid(info.data(), 1);
+        const auto sse41 = (info[2] & (1 << 19)) != 0;
+        const auto fma = (info[2] & (1 << 12)) != 0;
+        const auto os_avx = (info[2] & (1 << 27)) != 0 && (::_xgetbv(0) & 0x6) == 0x6;
+
+        auto avx2 = false;
+        if (max_leaf >= 7) {
+            ::__cpuidex(info.data(), 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+#    else
+        const auto sse41 = __builtin_cpu_supports("sse4.1") != 0;
+        const auto fma = __builtin_cpu_supports("fma") != 0;
+        const auto avx2 = __builtin_cpu_supports("avx2") != 0;
+        const auto os_avx = true; // note : already checked by __builtin_cpu_supports
+#    endif
+        if (avx2 && fma && os_avx) { return ISA::AVX2; }
+        if (sse41) { return ISA::SSE4; }
+#endif
+        return ISA::SCALAR;
+    }();
+    return isa;
+}
+
+auto engine::core::simd::is_supported(ISA isa) noexcept -> bool
+{
+    return static_cast<int>(isa) <= static_cast<int>(detect_isa());
+}
+
+auto engine::core::simd::compute_transforms(
+    const TransformInputs &in, float *out, std::size_t count, ISA isa) noexcept -> void
+{
+    if (!is_supported(isa)) { isa = detect_isa(); }
+
+    std::size_t done{0};
+#if defined(ENGINE_TRANSFORM_KERNEL_X86)
+    switch (isa) {
+    case ISA::AVX2: done = detail::compute_transforms_avx2(in, out, count); break;
+    case ISA::SSE4: done = detail::compute_transforms_sse4(in, out, count); break;
+    case ISA::SCALAR: break;
+    }
+#endif
+    // note : the remaining entities do not fill a whole register
+    detail::compute_transforms_scalar(in, out, done, count);
+}
+
+auto engine::core::simd::detail::compute_transforms_scalar(
+    const TransformInputs &in, float *out, std::size_t first, std::size_t count) noexcept -> std::size_t
+{
+    for (auto i = first; i < count; i++) {
+        const auto sa = std::sin(in.rotation[0][i] * DEG_TO_RAD);
+        const auto ca = std::cos(in.rotation[0][i] * DEG_TO_RAD);
+        const auto sb = std::sin(in.rotation[1][i] * DEG_TO_RAD);
+        const auto cb = std::cos(in.rotation[1][i] * DEG_TO_RAD);
+        const auto sc = std::sin(in.rotation[2][i] * DEG_TO_RAD);
+        const auto cc = std::cos(in.rotation[2][i] * DEG_TO_RAD);
+        const auto sx = in.scale[0][i];
+        const auto sy = in.scale[1][i];
+        const auto sz = in.scale[2][i];
+
+        auto m = out + i * 16;
+        m[0] = cb * cc * sx;
+        m[1] = (ca * sc + sa * sb * cc) * sx;
+        m[2] = (sa * sc - ca * sb * cc) * sx;
+        m[3] = 0.0f;
+        m[4] = -cb * sc * sy;
+        m[5] = (ca * cc - sa * sb * sc) * sy;
+        m[6] = (sa * cc + ca * sb * sc) * sy;
+        m[7] = 0.0f;
+        m[8] = sb * sz;
+        m[9] = -sa * cb * sz;
+        m[10] = ca * cb * sz;
+        m[11] = 0.0f;
+        m[12] = in.position[0][i];
+        m[13] = in.position[1][i];
+        m[14] = in.position[2][i];
+        m[15] = 1.0f;
+    }
+    return count > first ? count - first : 0;
+}
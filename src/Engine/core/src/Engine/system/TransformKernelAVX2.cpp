@@ -0,0 +1,74 @@
+// note : compiled with AVX2 and FMA enabled, only called when the cpu support it
+
+#include <immintrin.h>
+
+#include "TransformKernelPacked.hpp"
+
+namespace {
+
+struct AVX2 {
+    using type = __m256;
+    static constexpr std::size_t WIDTH{8};
+
+    static auto load(const float *p) noexcept { return _mm256_loadu_ps(p); }
+    static auto set1(float v) noexcept { return _mm256_set1_ps(v); }
+
+    static auto add(type a, type b) noexcept { return _mm256_add_ps(a, b); }
+    static auto sub(type a, type b) noexcept { return _mm256_sub_ps(a, b); }
+    static auto mul(type a, type b) noexcept { return _mm256_mul_ps(a, b); }
+
+    // a * b + c
+    static auto fmadd(type a, type b, type c) noexcept { return _mm256_fmadd_ps(a, b, c); }
+
+    // c - a * b
+    static auto fnmadd(type a, type b, type c) noexcept { return _mm256_fnmadd_ps(a, b, c); }
+
+    static auto round(type a) noexcept
+    {
+        return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    // mask of the lanes where the integer value of `a` has `bit` set
+    static auto bit_set(type a, int bit) noexcept
+    {
+        const auto b = _mm256_set1_epi32(bit);
+        return _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(_mm256_cvtps_epi32(a), b), b));
+    }
+
+    // mask ? a : b
+    static auto select(type mask, type a, type b) noexcept { return _mm256_blendv_ps(b, a, mask); }
+
+    static auto negate_if(type mask, type a) noexcept
+    {
+        return _mm256_xor_ps(a, _mm256_and_ps(mask, _mm256_set1_ps(-0.0f)));
+    }
+
+    // r0..r3 hold the rows of the column `column` of 8 consecutive matrices
+    static auto store_column(type r0, type r1, type r2, type r3, float *matrices, std::size_t column) noexcept
+    {
+        // transpose each 128 bits half : the low half hold the matrices 0..3, the high half 4..7
+        const auto t0 = _mm256_unpacklo_ps(r0, r1);
+        const auto t1 = _mm256_unpackhi_ps(r0, r1);
+        const auto t2 = _mm256_unpacklo_ps(r2, r3);
+        const auto t3 = _mm256_unpackhi_ps(r2, r3);
+
+        const type c[4] = {
+            _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+            _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+            _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+            _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2))};
+
+        for (std::size_t i = 0; i != 4; i++) {
+            _mm_storeu_ps(matrices + i * 16 + column * 4, _mm256_castps256_ps128(c[i]));
+            _mm_storeu_ps(matrices + (i + 4) * 16 + column * 4, _mm256_extractf128_ps(c[i], 1));
+        }
+    }
+};
+
+} // namespace
+
+auto engine::core::simd::detail::compute_transforms_avx2(
+    const TransformInputs &in, float *out, std::size_t count) noexcept -> std::size_t
+{
+    return compute_transforms_packed<AVX2>(in, out, count);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+// Generic implementation of the transform kernel over a register type `V`, see TransformKernelSSE4.cpp
+// and TransformKernelAVX2.cpp. This file must only be included by the files compiled for a specific
+// instruction set and everything stay in an anonymous namespace so nothing leak between them.
+
+#include "Engine/system/TransformKernel.hpp"
+
+namespace {
+
+// clang-format off
+constexpr auto DEG_TO_RAD   = 0.01745329251994329576923690768489f;
+constexpr auto TWO_OVER_PI  = 0.63661977236758134307553505349006f;
+constexpr auto PI_OVER_2_HI = 1.5707963705062866211f;  // float(pi / 2)
+constexpr auto PI_OVER_2_LO = -4.3711390001862427e-8f; // pi / 2 - float(pi / 2)
+
+// minimax polynomial on [-pi/4, pi/4] (cephes)
+constexpr auto SIN_1 = -1.6666654611e-1f;
+constexpr auto SIN_2 = 8.3321608736e-3f;
+constexpr auto SIN_3 = -1.9515295891e-4f;
+constexpr auto COS_1 = 4.166664568298827e-2f;
+constexpr auto COS_2 = -1.388731625493765e-3f;
+constexpr auto COS_3 = 2.443315711809948e-5f;
+// clang-format on
+
+// sin and cos of an angle in degree
+template<typename V>
+auto sincos(typename V::type degree, typename V::type &sin, typename V::type &cos) noexcept -> void
+{
+    const auto x = V::mul(degree, V::set1(DEG_TO_RAD));
+
+    // reduce to [-pi/4, pi/4] : x = quadrant * pi/2 + r
+    const auto quadrant = V::round(V::mul(x, V::set1(TWO_OVER_PI)));
+    auto r = V::fnmadd(quadrant, V::set1(PI_OVER_2_HI), x);
+    r = V::fnmadd(quadrant, V::set1(PI_OVER_2_LO), r);
+
+    const auto r2 = V::mul(r, r);
+
+    auto s = V::fmadd(r2, V::set1(SIN_3), V::set1(SIN_2));
+    s = V::fmadd(r2, s, V::set1(SIN_1));
+    s = V::fmadd(V::mul(r2, r), s, r);
+
+    auto c = V::fmadd(r2, V::set1(COS_3), V::set1(COS_2));
+    c = V::fmadd(r2, c, V::set1(COS_1));
+    c = V::fmadd(V::mul(r2, r2), c, V::fnmadd(r2, V::set1(0.5f), V::set1(1.0f)));
+
+    // odd quadrant swap sin and cos, the sign follow the quadrant
+    const auto swap = V::bit_set(quadrant, 1);
+    sin = V::negate_if(V::bit_set(quadrant, 2), V::select(swap, c, s));
+    cos = V::negate_if(V::bit_set(V::add(quadrant, V::set1(1.0f)), 2), V::select(swap, s, c));
+}
+
+template<typename V>
+auto compute_transforms_packed(
+    const engine::core::simd::TransformInputs &in, float *out, std::size_t count) noexcept -> std::size_t
+{
+    const auto packed = count - count % V::WIDTH;
+    const auto zero = V::set1(0.0f);
+    const auto one = V::set1(1.0f);
+
+    for (std::size_t i = 0; i != packed; i += V::WIDTH) {
+        typename V::type sa, ca, sb, cb, sc, cc;
+        sincos<V>(V::load(in.rotation[0] + i), sa, ca);
+        sincos<V>(V::load(in.rotation[1] + i), sb, cb);
+        sincos<V>(V::load(in.rotation[2] + i), sc, cc);
+
+        const auto sx = V::load(in.scale[0] + i);
+        const auto sy = V::load(in.scale[1] + i);
+        const auto sz = V::load(in.scale[2] + i);
+
+        const auto sa_sb = V::mul(sa, sb);
+        const auto ca_sb = V::mul(ca, sb);
+
+        const auto m0 = V::mul(V::mul(cb, cc), sx);
+        const auto m1 = V::mul(V::fmadd(sa_sb, cc, V::mul(ca, sc)), sx);
+        const auto m2 = V::mul(V::fnmadd(ca_sb, cc, V::mul(sa, sc)), sx);
+
+        const auto m4 = V::mul(V::mul(V::sub(zero, cb), sc), sy);
+        const auto m5 = V::mul(V::fnmadd(sa_sb, sc, V::mul(ca, cc)), sy);
+        const auto m6 = V::mul(V::fmadd(ca_sb, sc, V::mul(sa, cc)), sy);
+
+        const auto m8 = V::mul(sb, sz);
+        const auto m9 = V::mul(V::mul(V::sub(zero, sa), cb), sz);
+        const auto m10 = V::mul(V::mul(ca, cb), sz);
+
+        const auto px = V::load(in.position[0] + i);
+        const auto py = V::load(in.position[1] + i);
+        const auto pz = V::load(in.position[2] + i);
+
+        auto matrices = out + i * 16;
+        V::store_column(m0, m1, m2, zero, matrices, 0);
+        V::store_column(m4, m5, m6, zero, matrices, 1);
+        V::store_column(m8, m9, m10, zero, matrices, 2);
+        V::store_column(px, py, pz, one, matrices, 3);
+    }
+
+    return packed;
+}
+
+} // namespace
@@ -0,0 +1,63 @@
+// note : compiled with SSE 4.1 enabled, only called when the cpu support it
+
+#include <smmintrin.h>
+
+#include "TransformKernelPacked.hpp"
+
+namespace {
+
+struct SSE4 {
+    using type = __m128;
+    static constexpr std::size_t WIDTH{4};
+
+    static auto load(const float *p) noexcept { return _mm_loadu_ps(p); }
+    static auto set1(float v) noexcept { return _mm_set1_ps(v); }
+
+    static auto add(type a, type b) noexcept { return _mm_add_ps(a, b); }
+    static auto sub(type a, type b) noexcept { return _mm_sub_ps(a, b); }
+    static auto mul(type a, type b) noexcept { return _mm_mul_ps(a, b); }
+
+    // a * b + c
+    static auto fmadd(type a, type b, type c) noexcept { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+
+    // c - a * b
+    static auto fnmadd(type a, type b, type c) noexcept { return _mm_sub_ps(c, _mm_mul_ps(a, b)); }
+
+    static auto round(type a) noexcept
+    {
+        return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    // mask of the lanes where the integer value of `a` has `bit` set
+    static auto bit_set(type a, int bit) noexcept
+    {
+        const auto b = _mm_set1_epi32(bit);
+        return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(_mm_cvtps_epi32(a), b), b));
+    }
+
+    // mask ? a : b
+    static auto select(type mask, type a, type b) noexcept { return _mm_blendv_ps(b, a, mask); }
+
+    static auto negate_if(type mask, type a) noexcept
+    {
+        return _mm_xor_ps(a, _mm_and_ps(mask, _mm_set1_ps(-0.0f)));
+    }
+
+    // r0..r3 hold the rows of the column `column` of 4 consecutive matrices
+    static auto store_column(type r0, type r1, type r2, type r3, float *matrices, std::size_t column) noexcept
+    {
+        _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+        _mm_storeu_ps(matrices + 0 * 16 + column * 4, r0);
+        _mm_storeu_ps(matrices + 1 * 16 + column * 4, r1);
+        _mm_storeu_ps(matrices + 2 * 16 + column * 4, r2);
+        _mm_storeu_ps(matrices + 3 * 16 + column * 4, r3);
+    }
+};
+
+} // namespace
+
+auto engine::core::simd::detail::compute_transforms_sse4(
+    const TransformInputs &in, float *out, std::size_t count) noexcept -> std::size_t
+{
+    return compute_transforms_packed<SSE4>(in, out, count);
+}
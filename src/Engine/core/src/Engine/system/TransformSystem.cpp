@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <limits>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <Engine/helpers/debug.hpp>
+
+#include "Engine/third_party.hpp"
+#include "Engine/system/TransformSystem.hpp"
+
+engine::core::TransformSystem::TransformSystem(entt::registry &world) : m_world{world}
+{
+    CALL_OPEN_GL(::glCreateBuffers(1, &m_buffer));
+    api::debug_label(GL_BUFFER, m_buffer, "TransformSystem matrices");
+
+    // note : the VAO is observed so every renderable entity get a Transform
+    connect<api::VAO, api::Position3f, api::Rotation3f, api::Scale3f>();
+    m_world.on_destroy<api::Transform>().connect<&TransformSystem::on_destroy_transform>(*this);
+}
+
+engine::core::TransformSystem::~TransformSystem()
+{
+    m_world.on_destroy<api::Transform>().disconnect<&TransformSystem::on_destroy_transform>(*this);
+    disconnect<api::VAO, api::Position3f, api::Rotation3f, api::Scale3f>();
+
+    CALL_OPEN_GL(::glDeleteBuffers(1, &m_buffer));
+}
+
+auto engine::core::TransformSystem::compute(
+    const glm::vec3 &position, const glm::vec3 &rotation, const glm::vec3 &scale) -> glm::mat4
+{
+    auto model = glm::mat4(1.0f);
+    model = glm::translate(model, position);
+    model = glm::rotate(model, glm::radians(rotation.x), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotation.y), glm::vec3(0.0f, 1.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotation.z), glm::vec3(0.0f, 0.0f, 1.0f));
+    model = glm::scale(model, scale);
+    return model;
+}
+
+auto engine::core::TransformSystem::on_destroy_transform(entt::registry &world, entt::entity entity) -> void
+{
+    m_free_slots.push_back(world.get<api::Transform>(entity).slot);
+}
+
+auto engine::core::TransformSystem::update() -> void
+{
+    static constexpr auto NO_POSITION = glm::vec3{0.0f, 0.0f, 0.0f};
+    static constexpr auto NO_ROTATION = glm::vec3{0.0f, 0.0f, 0.0f};
+    static constexpr auto NO_SCALE = glm::vec3{1.0f, 1.0f, 1.0f};
+
+    m_stats = {};
+    if (m_dirty.empty()) { return; }
+
+    std::sort(m_dirty.begin(), m_dirty.end());
+    m_dirty.erase(std::unique(m_dirty.begin(), m_dirty.end()), m_dirty.end());
+
+    // gather the transform of the dirty entities as a structure of arrays for the kernel
+
+    m_pending.clear();
+    // note : m_dirty is cleared before the kernel run, the stride is kept aside
+    const auto stride = m_dirty.size();
+    m_inputs.resize(stride * 9);
+    const auto input = [this, stride](std::size_t component) { return m_inputs.data() + component * stride; };
+
+    for (const auto entity : m_dirty) {
+        if (!m_world.valid(entity)) { continue; }
+
+        const auto pos = m_world.try_get<api::Position3f>(entity);
+        const auto rot = m_world.try_get<api::Rotation3f>(entity);
+        const auto scale = m_world.try_get<api::Scale3f>(entity);
+        if (!m_world.has<api::VAO>(entity) && !pos && !rot && !scale) {
+            m_world.remove_if_exists<api::Transform>(entity);
+            continue;
+        }
+
+        const auto i = m_pending.size();
+        for (auto axis = 0; axis != 3; axis++) {
+            const auto index = static_cast<std::size_t>(axis);
+            input(0 + index)[i] = (pos ? pos->vec : NO_POSITION)[axis];
+            input(3 + index)[i] = (rot ? rot->vec : NO_ROTATION)[axis];
+            input(6 + index)[i] = (scale ? scale->vec : NO_SCALE)[axis];
+        }
+        m_pending.push_back(entity);
+    }
+    m_dirty.clear();
+
+    if (m_pending.empty()) { return; }
+
+    const simd::TransformInputs inputs{
+        {input(0), input(1), input(2)}, {input(3), input(4), input(5)}, {input(6), input(7), input(8)}};
+    m_outputs.resize(m_pending.size());
+    simd::compute_transforms(inputs, glm::value_ptr(m_outputs.front()), m_pending.size(), m_isa);
+
+    // scatter the results in the components and the cpu mirror
+
+    auto first = std::numeric_limits<std::size_t>::max();
+    auto last = std::size_t{0};
+
+    for (auto i = 0ul; i != m_pending.size(); i++) {
+        const auto entity = m_pending[i];
+        const auto &model = m_outputs[i];
+
+        std::uint32_t slot{};
+        if (const auto transform = m_world.try_get<api::Transform>(entity); transform) {
+            slot = transform->slot;
+            m_world.patch<api::Transform>(entity, [&model](api::Transform &t) { t.world = model; });
+        } else {
+            if (m_free_slots.empty()) {
+                slot = static_cast<std::uint32_t>(m_matrices.size());
+                m_matrices.emplace_back();
+            } else {
+                slot = m_free_slots.back();
+                m_free_slots.pop_back();
+            }
+            m_world.emplace<api::Transform>(entity, model, slot);
+        }
+
+        m_matrices[slot] = model;
+        first = std::min(first, std::size_t{slot});
+        last = std::max(last, std::size_t{slot} + 1);
+    }
+    m_stats.computed = m_pending.size();
+
+    if (m_matrices.size() > m_capacity) {
+        m_capacity = std::max(m_matrices.size(), m_capacity * 2);
+        CALL_OPEN_GL(::glNamedBufferData(
+            m_buffer, static_cast<GLsizeiptr>(m_capacity * sizeof(glm::mat4)), nullptr, GL_DYNAMIC_DRAW));
+        first = 0;
+        last = m_matrices.size();
+    }
+
+    CALL_OPEN_GL(::glNamedBufferSubData(
+        m_buffer,
+        static_cast<GLintptr>(first * sizeof(glm::mat4)),
+        static_cast<GLsizeiptr>((last - first) * sizeof(glm::mat4)),
+        m_matrices.data() + first));
+    m_stats.uploaded = last - first;
+}
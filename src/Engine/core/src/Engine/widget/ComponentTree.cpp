@@ -2,32 +2,38 @@
 
 #include "Engine/widget/ComponentTree.hpp"
 
-// todo : should use world.patch
+template<>
+auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Position3f &position) const -> bool
+{
+    return ImGui::InputFloat3("position", &position.vec.x, 3);
+}
 
 template<>
-auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Position3f &position) const -> void
+auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Rotation3f &rotation) const -> bool
 {
-    ImGui::InputFloat3("position", &position.vec.x, 3);
+    return ImGui::InputFloat3("rotation", &rotation.vec.x, 3);
 }
 
 template<>
-auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Rotation3f &rotation) const -> void
+auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Scale3f &scale) const -> bool
 {
-    ImGui::InputFloat3("rotation", &rotation.vec.x, 3);
+    return ImGui::InputFloat3("scale", &scale.vec.x, 3);
 }
 
 template<>
-auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Scale3f &scale) const -> void
+auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Tint4f &tint) const -> bool
 {
-    ImGui::InputFloat3("scale", &scale.vec.x, 3);
+    return ImGui::ColorEdit4("tint", &tint.vec.x);
 }
 
 template<>
-auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Name &name) const -> void
+auto engine::core::widget::ComponentTree::drawComponentTweaker(api::Name &name) const -> bool
 {
     char buffer[255] = {0};
     std::strcpy(buffer, name.str.data());
-    if (ImGui::InputText("name", buffer, sizeof(buffer))) { name.str = buffer; }
+    if (!ImGui::InputText("name", buffer, sizeof(buffer))) { return false; }
+    name.str = buffer;
+    return true;
 }
 
 auto engine::core::widget::ComponentTree::draw(entt::registry &world) const -> void
@@ -59,7 +65,11 @@ auto engine::core::widget::ComponentTree::draw(entt::registry &world) const -> v
                         if (ImGui::BeginTabItem(Variant::name.data())) {
                             ImGui::TextWrapped(
                                 R"(Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. )");
-                            this->drawComponentTweaker(world.get<Variant>(e));
+                            // note : the component is edited through a copy so the observers are notified
+                            auto component = world.get<Variant>(e);
+                            if (this->drawComponentTweaker(component)) {
+                                world.patch<Variant>(e, [&component](Variant &c) { c = component; });
+                            }
                             ImGui::SameLine();
                             if (ImGui::Button(fmt::format("Delete###{}", Variant::name).data())) {
                                 spdlog::warn("Deleting component {} of {}", Variant::name, e);
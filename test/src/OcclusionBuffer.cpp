@@ -0,0 +1,44 @@
+#include <array>
+#include <cstdint>
+
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/graphics/OcclusionBuffer.hpp>
+
+using engine::core::OcclusionBuffer;
+
+namespace {
+
+// quad in normalized device coordinates, the view projection and the models are the identity
+auto rasterize_quad(OcclusionBuffer &buffer, float left, float right, float depth) -> void
+{
+    const auto positions = std::to_array<glm::vec3>(
+        {{left, -1.0f, depth}, {right, -1.0f, depth}, {right, 1.0f, depth}, {left, 1.0f, depth}});
+    const auto indices = std::to_array<std::uint32_t>({0, 1, 2, 0, 2, 3});
+
+    buffer.begin(glm::mat4{1.0f});
+    buffer.addMesh(glm::mat4{1.0f}, positions, indices);
+    for (std::size_t band = 0; band != OcclusionBuffer::BANDS; band++) { buffer.rasterize(band); }
+}
+
+} // namespace
+
+TEST_CASE("a full screen occluder hides the boxes behind it only", "[occlusion]")
+{
+    OcclusionBuffer buffer;
+    rasterize_quad(buffer, -1.0f, 1.0f, 0.0f);
+    REQUIRE(buffer.getTriangleCount() == 2);
+
+    CHECK_FALSE(buffer.isVisible({-0.2f, -0.2f, 0.5f}, {0.2f, 0.2f, 0.8f}, glm::mat4{1.0f}));
+    CHECK(buffer.isVisible({-0.2f, -0.2f, -0.8f}, {0.2f, 0.2f, -0.5f}, glm::mat4{1.0f}));
+}
+
+TEST_CASE("a box outside of the occluders stays visible", "[occlusion]")
+{
+    OcclusionBuffer buffer;
+    rasterize_quad(buffer, -1.0f, 0.0f, 0.0f);
+
+    CHECK_FALSE(buffer.isVisible({-0.6f, -0.2f, 0.5f}, {-0.3f, 0.2f, 0.8f}, glm::mat4{1.0f}));
+    CHECK(buffer.isVisible({0.3f, -0.2f, 0.5f}, {0.6f, 0.2f, 0.8f}, glm::mat4{1.0f}));
+}
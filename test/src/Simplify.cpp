@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+
+#include <Engine/helpers/simplify.hpp>
+
+namespace {
+
+constexpr std::uint32_t CELLS{16};
+
+// flat grid of CELLS x CELLS quads in the plane z = 0, the triangles face +z
+struct Grid {
+    Grid()
+    {
+        for (std::uint32_t y = 0; y <= CELLS; y++) {
+            for (std::uint32_t x = 0; x <= CELLS; x++) {
+                positions.insert(positions.end(), {static_cast<float>(x), static_cast<float>(y), 0.0f});
+            }
+        }
+        for (std::uint32_t y = 0; y != CELLS; y++) {
+            for (std::uint32_t x = 0; x != CELLS; x++) {
+                const auto a = vertex(x, y);
+                const auto b = vertex(x + 1, y);
+                const auto c = vertex(x + 1, y + 1);
+                const auto d = vertex(x, y + 1);
+                indices.insert(indices.end(), {a, b, c, a, c, d});
+            }
+        }
+    }
+
+    static auto vertex(std::uint32_t x, std::uint32_t y) -> std::uint32_t { return y * (CELLS + 1) + x; }
+
+    [[nodiscard]] auto point(std::uint32_t index) const -> glm::vec3
+    {
+        return {positions[index * 3], positions[index * 3 + 1], positions[index * 3 + 2]};
+    }
+
+    std::vector<float> positions;
+    std::vector<std::uint32_t> indices;
+};
+
+} // namespace
+
+TEST_CASE("the simplification of a grid reaches the target", "[simplify]")
+{
+    const Grid grid;
+    const auto target = grid.indices.size() / 4;
+
+    const auto result = engine::api::simplify(grid.indices, grid.positions, 3, target, 0.01f);
+
+    REQUIRE(result.size() % 3 == 0);
+    CHECK(!result.empty());
+    CHECK(result.size() <= target);
+
+    SECTION("the border vertices are kept")
+    {
+        for (std::uint32_t i = 0; i <= CELLS; i++) {
+            const auto border = {
+                Grid::vertex(i, 0), Grid::vertex(i, CELLS), Grid::vertex(0, i), Grid::vertex(CELLS, i)};
+            for (const auto vertex : border) {
+                CHECK(std::find(result.begin(), result.end(), vertex) != result.end());
+            }
+        }
+    }
+
+    SECTION("no triangle is flipped")
+    {
+        for (std::size_t i = 0; i != result.size(); i += 3) {
+            const auto a = grid.point(result[i]);
+            const auto normal = glm::cross(grid.point(result[i + 1]) - a, grid.point(result[i + 2]) - a);
+            CHECK(normal.z > 0.0f);
+        }
+    }
+}
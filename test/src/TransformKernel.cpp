@@ -0,0 +1,48 @@
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include <Engine/system/TransformKernel.hpp>
+#include <Engine/system/TransformSystem.hpp>
+
+using engine::core::TransformSystem;
+using engine::core::simd::ISA;
+
+TEST_CASE("the transform kernel match the reference implementation", "[transform]")
+{
+    const auto isa = GENERATE(ISA::SCALAR, ISA::SSE4, ISA::AVX2);
+    if (!engine::core::simd::is_supported(isa)) { return; }
+
+    const glm::vec3 position{1.0f, -2.0f, 3.0f};
+    const glm::vec3 rotation{30.0f, -45.0f, 60.0f};
+    const glm::vec3 scale{2.0f, 0.5f, 3.0f};
+
+    // same layout as the gather of TransformSystem::update, enough entities to fill a register and a tail
+    constexpr auto count = std::size_t{9};
+    std::vector<float> soa(count * 9);
+    const auto input = [&soa](std::size_t component) { return soa.data() + component * count; };
+    for (auto i = 0ul; i != count; i++) {
+        for (auto axis = 0; axis != 3; axis++) {
+            const auto index = static_cast<std::size_t>(axis);
+            input(0 + index)[i] = position[axis];
+            input(3 + index)[i] = rotation[axis];
+            input(6 + index)[i] = scale[axis];
+        }
+    }
+    const engine::core::simd::TransformInputs inputs{
+        {input(0), input(1), input(2)}, {input(3), input(4), input(5)}, {input(6), input(7), input(8)}};
+
+    std::vector<glm::mat4> out(count);
+    engine::core::simd::compute_transforms(inputs, glm::value_ptr(out.front()), count, isa);
+
+    const auto expected = TransformSystem::compute(position, rotation, scale);
+    for (const auto &model : out) {
+        for (auto column = 0; column != 4; column++) {
+            for (auto row = 0; row != 4; row++) {
+                CHECK(model[column][row] == Approx(expected[column][row]).margin(1e-5));
+            }
+        }
+    }
+}